@@ -10,26 +10,36 @@
 #include <jlm/util/file.hpp>
 #include <jlm/util/stats.hpp>
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace jlm {
 
-enum class outputformat {llvm, xml};
+enum class outputformat {llvm, bc, xml};
 
 class cmdline_options {
 public:
 	cmdline_options()
 	: ifile("")
 	, ofile("")
+	, tfile("")
 	, format(outputformat::llvm)
+	, nthreads(1)
+	, njobs(1)
 	{}
 
 	jlm::filepath ifile;
 	jlm::filepath ofile;
+	jlm::filepath tfile;
 	outputformat format;
+	size_t nthreads;
+	size_t njobs;
+	std::vector<std::pair<jlm::filepath, jlm::filepath>> batch;
 	stats_descriptor sd;
 	std::vector<jlm::optimization> optimizations;
+	std::unique_ptr<jlm::pipeline> pipeline;
 };
 
 void
@@ -5,10 +5,63 @@
 
 #include <jlm-opt/cmdline.hpp>
 
+#include <jlm/common.hpp>
+
 #include <llvm/Support/CommandLine.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
 namespace jlm {
 
+static std::string
+suffix(const outputformat & format)
+{
+	static std::unordered_map<outputformat, std::string> map({
+	  {outputformat::llvm, ".opt.ll"}
+	, {outputformat::bc, ".opt.bc"}
+	, {outputformat::xml, ".opt.xml"}
+	});
+
+	JLM_DEBUG_ASSERT(map.find(format) != map.end());
+	return map[format];
+}
+
+/*
+	Parses a batch file. Every line contains an input file optionally
+	followed by an output file. Empty lines and lines starting with '#'
+	are ignored. The output file defaults to the input file with the
+	suffix \p suffix.
+*/
+static std::vector<std::pair<jlm::filepath, jlm::filepath>>
+parse_batch_file(const jlm::filepath & path, const std::string & suffix)
+{
+	std::ifstream ifs(path.to_str());
+	if (!ifs)
+		throw jlm::error("Cannot open batch file " + path.to_str());
+
+	std::string line;
+	std::vector<std::pair<jlm::filepath, jlm::filepath>> batch;
+	while (std::getline(ifs, line)) {
+		std::string ifile, ofile;
+		std::istringstream iss(line);
+		if (!(iss >> ifile) || ifile[0] == '#')
+			continue;
+
+		if (!(iss >> ofile)) {
+			jlm::filepath fp(ifile);
+			ofile = fp.path() + fp.base() + suffix;
+		}
+
+		batch.push_back({jlm::filepath(ifile), jlm::filepath(ofile)});
+	}
+
+	return batch;
+}
+
 void
 parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 {
@@ -43,84 +96,70 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 	, cl::desc(desc)
 	, cl::value_desc("file"));
 
-	cl::opt<bool> print_cfr_time(
-	  "print-cfr-time"
-	, cl::ValueDisallowed
-	, cl::desc("Write CFR time to stats file."));
-
-	cl::opt<bool> print_aggregation_time(
-	  "print-aggregation-time"
-	, cl::ValueDisallowed
-	, cl::desc("Write aggregation time to stats file."));
-
-	cl::opt<bool> print_annotation_time(
-	  "print-annotation-time"
-	, cl::ValueDisallowed
-	, cl::desc("Write annotation time to stats file."));
-
-	cl::opt<bool> print_rvsdg_construction(
-	  "print-rvsdg-construction"
-	, cl::ValueDisallowed
-	, cl::desc("Write RVSDG construction stats to file."));
-
-	cl::opt<bool> print_rvsdg_destruction(
-	  "print-rvsdg-destruction"
-	, cl::ValueDisallowed
-	, cl::desc("Write RVSDG destruction stats to file."));
-
-	cl::opt<bool> print_rvsdg_optimization(
-	  "print-rvsdg-optimization"
-	, cl::ValueDisallowed
-	, cl::desc("Write RVSDG optimization stats to file."));
-
-	cl::opt<bool> print_dne_stat(
-	  "print-dne-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write dead node elimination statistics to file."));
-
-	cl::opt<bool> print_cne_stat(
-	  "print-cne-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write common node elimination statistics to file."));
-
-	cl::opt<bool> print_iln_stat(
-	  "print-iln-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write function inlining statistics to file."));
-
-	cl::opt<bool> print_inv_stat(
-	  "print-inv-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write invariant value reduction statistics to file."));
-
-	cl::opt<bool> print_ivt_stat(
-	  "print-ivt-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write theta-gamma inversion statistics to file."));
-
-	cl::opt<bool> print_pull_stat(
-	  "print-pull-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write pull statistics to file."));
-
-	cl::opt<bool> print_push_stat(
-	  "print-push-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write push statistics to file."));
+	cl::opt<std::string> tfile(
+	  "trace"
+	, cl::desc("Write a Chrome trace-event profile of the compilation to <file>.")
+	, cl::value_desc("file"));
 
-	cl::opt<bool> print_reduction_stat(
-	  "print-reduction-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write reduction statistics to file."));
+	std::vector<std::string> statnames({"all"});
+	for (const auto & id : all_statids())
+		statnames.push_back(to_str(id));
+	std::sort(statnames.begin(), statnames.end());
+
+	std::string statsdesc("Write the stats of <stat,...> to the stats file. Stats are:");
+	for (const auto & name : statnames)
+		statsdesc += " " + name;
+
+	cl::list<std::string> stats(
+	  "stats"
+	, cl::CommaSeparated
+	, cl::desc(statsdesc)
+	, cl::value_desc("stat,..."));
+
+	cl::opt<statformat> stats_format(
+	  "stats-format"
+	, cl::init(statformat::json)
+	, cl::values(
+		  clEnumValN(statformat::json, "json", "JSON lines [default]")
+		, clEnumValN(statformat::csv, "csv", "Comma separated values")
+		, clEnumValN(statformat::text, "text", "Space separated values"))
+	, cl::desc("Select stats format"));
+
+	cl::opt<size_t> nthreads(
+	  "threads"
+	, cl::init(1)
+	, cl::desc("Perform the cfg restructuring of rvsdg construction on <n> threads.")
+	, cl::value_desc("n"));
+
+	cl::opt<std::string> batchfile(
+	  "batch"
+	, cl::desc("Process all modules listed in <file>. Every line contains an input and an output file.")
+	, cl::value_desc("file"));
 
-	cl::opt<bool> print_unroll_stat(
-	  "print-unroll-stat"
-	, cl::ValueDisallowed
-	, cl::desc("Write loop unrolling statistics to file."));
+	cl::opt<size_t> njobs(
+	  "j"
+	, cl::Prefix
+	, cl::init(1)
+	, cl::desc("Overlap the parsing, LLVM conversion, and output of up to <n> modules of a batch.")
+	, cl::value_desc("n"));
+
+	cl::opt<size_t> olvl(
+	  "O"
+	, cl::Prefix
+	, cl::init(0)
+	, cl::desc("Perform the optimizations of level <n>. [0-3]")
+	, cl::value_desc("n"));
+
+	cl::opt<std::string> pipeline(
+	  "pipeline"
+	, cl::desc("Perform the optimizations of <pipeline>, e.g. iln,repeat[8](red,cne,dne).")
+	, cl::value_desc("pipeline"));
 
 	cl::opt<outputformat> format(
-	  cl::values(
+	  cl::init(outputformat::llvm)
+	, cl::values(
 		  clEnumValN(outputformat::llvm, "llvm", "Output LLVM IR [default]")
+		, clEnumValN(outputformat::bc, "bc", "Output LLVM bitcode")
 		, clEnumValN(outputformat::xml, "xml", "Output XML"))
 	, cl::desc("Select output format"));
 
@@ -150,24 +189,58 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 	if (!sfile.empty())
 		options.sd.set_file(sfile);
 
+	if (!tfile.empty())
+		options.tfile = tfile;
+
 	options.ifile = ifile;
 	options.format = format;
+	options.nthreads = nthreads;
+	options.njobs = std::max(size_t(1), size_t(njobs));
 	options.optimizations = optimizations;
-	options.sd.print_cfr_time = print_cfr_time;
-	options.sd.print_cne_stat = print_cne_stat;
-	options.sd.print_dne_stat = print_dne_stat;
-	options.sd.print_iln_stat = print_iln_stat;
-	options.sd.print_inv_stat = print_inv_stat;
-	options.sd.print_ivt_stat = print_ivt_stat;
-	options.sd.print_pull_stat = print_pull_stat;
-	options.sd.print_push_stat = print_push_stat;
-	options.sd.print_reduction_stat = print_reduction_stat;
-	options.sd.print_unroll_stat = print_unroll_stat;
-	options.sd.print_annotation_time = print_annotation_time;
-	options.sd.print_aggregation_time = print_aggregation_time;
-	options.sd.print_rvsdg_construction = print_rvsdg_construction;
-	options.sd.print_rvsdg_destruction = print_rvsdg_destruction;
-	options.sd.print_rvsdg_optimization = print_rvsdg_optimization;
+	options.sd.set_format(stats_format);
+
+	try {
+		for (const auto & stat : stats) {
+			if (stat == "all")
+				options.sd.enable_all();
+			else
+				options.sd.enable(to_statid(stat));
+		}
+	} catch (jlm::error & e) {
+		std::cerr << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+
+	if (!batchfile.empty() && !ifile.empty()) {
+		std::cerr << "An input file cannot be combined with --batch.\n";
+		exit(EXIT_FAILURE);
+	}
+
+	try {
+		if (!batchfile.empty())
+			options.batch = parse_batch_file(batchfile, suffix(format));
+	} catch (jlm::error & e) {
+		std::cerr << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+
+	size_t nspecs = !optimizations.empty() + !pipeline.empty() + (olvl.getNumOccurrences() != 0);
+	if (nspecs > 1) {
+		std::cerr << "Only one of -O<n>, --pipeline, and individual optimizations can be given.\n";
+		exit(EXIT_FAILURE);
+	}
+
+	try {
+		if (!pipeline.empty())
+			options.pipeline = parse_pipeline(pipeline);
+		else if (olvl.getNumOccurrences() != 0)
+			options.pipeline = create_pipeline(olvl);
+		else
+			options.pipeline = optimization_pipeline::create(optimizations);
+	} catch (jlm::error & e) {
+		std::cerr << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
 }
 
 }
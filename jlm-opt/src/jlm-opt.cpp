@@ -13,16 +13,72 @@
 #include <jlm/llvm2jlm/module.hpp>
 #include <jlm/opt/optimization.hpp>
 #include <jlm/rvsdg2jlm/rvsdg2jlm.hpp>
+#include <jlm/util/parallel.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/time.hpp>
+#include <jlm/util/trace.hpp>
 
 #include <jlm-opt/cmdline.hpp>
 
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/raw_os_ostream.h>
 #include <llvm/Support/SourceMgr.h>
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
+
+/*
+	FIXME: The RVSDG library keeps global state, e.g., its node notifiers.
+	Batch mode therefore does not process modules concurrently. It only
+	pipelines them: RVSDG construction, optimization, rvsdg2jlm, XML printing,
+	and destruction are performed for one module at a time, while parsing,
+	llvm2jlm, jlm2llvm, and writing the output of other modules overlap with
+	it.
+*/
+static std::mutex rvsdg_mutex;
+
+class module_stat final : public jlm::stat {
+public:
+	virtual
+	~module_stat()
+	{}
+
+	module_stat(const jlm::filepath & ifile, const jlm::filepath & ofile)
+	: stat(jlm::statid::module)
+	, ifile_(ifile)
+	, ofile_(ofile)
+	{}
+
+	void
+	start() noexcept
+	{
+		timer_.start();
+	}
+
+	void
+	end() noexcept
+	{
+		timer_.stop();
+	}
+
+	virtual std::vector<jlm::statfield>
+	fields() const override
+	{
+		return {
+		  {"file", ifile_.to_str()}, {"ofile", ofile_.to_str()}
+		, {"time_ns", timer_.ns()}
+		};
+	}
+
+private:
+	jlm::timer timer_;
+	jlm::filepath ifile_;
+	jlm::filepath ofile_;
+};
 
 static std::unique_ptr<llvm::Module>
 parse_llvm_file(
@@ -33,8 +89,10 @@ parse_llvm_file(
 	llvm::SMDiagnostic d;
 	auto module = llvm::parseIRFile(file.to_str(), d, ctx);
 	if (!module) {
-		d.print(executable, llvm::errs());
-		exit(EXIT_FAILURE);
+		std::string msg;
+		llvm::raw_string_ostream os(msg);
+		d.print(executable, os);
+		throw jlm::error(os.str());
 	}
 
 	return module;
@@ -54,22 +112,38 @@ print_as_xml(
 {
 	auto fd = fp == "" ? stdout : fopen(fp.to_str().c_str(), "w");
 
+	std::lock_guard<std::mutex> guard(rvsdg_mutex);
 	jive::view_xml(rm.graph()->root(), fd);
 
 	if (fd != stdout)
 			fclose(fd);
 }
 
+static std::unique_ptr<llvm::Module>
+destruct_rvsdg(
+	const jlm::rvsdg_module & rm,
+	llvm::LLVMContext & ctx,
+	const jlm::stats_descriptor & sd)
+{
+	std::unique_ptr<jlm::ipgraph_module> jlm_module;
+	{
+		jlm::trace_scope scope("phase", "rvsdg2jlm");
+		std::lock_guard<std::mutex> guard(rvsdg_mutex);
+		jlm_module = jlm::rvsdg2jlm::rvsdg2jlm(rm, sd);
+	}
+
+	jlm::trace_scope scope("phase", "jlm2llvm");
+	return jlm::jlm2llvm::convert(*jlm_module, ctx);
+}
+
 static void
 print_as_llvm(
 	const jlm::rvsdg_module & rm,
 	const jlm::filepath & fp,
 	const jlm::stats_descriptor & sd)
 {
-	auto jlm_module = jlm::rvsdg2jlm::rvsdg2jlm(rm, sd);
-
 	llvm::LLVMContext ctx;
-	auto llvm_module = jlm::jlm2llvm::convert(*jlm_module, ctx);
+	auto llvm_module = destruct_rvsdg(rm, ctx, sd);
 
 	if (fp == "") {
 		llvm::raw_os_ostream os(std::cout);
@@ -81,6 +155,23 @@ print_as_llvm(
 	}
 }
 
+static void
+print_as_bc(
+	const jlm::rvsdg_module & rm,
+	const jlm::filepath & fp,
+	const jlm::stats_descriptor & sd)
+{
+	llvm::LLVMContext ctx;
+	auto llvm_module = destruct_rvsdg(rm, ctx, sd);
+
+	std::error_code ec;
+	llvm::raw_fd_ostream os(fp == "" ? "-" : fp.to_str(), ec, llvm::sys::fs::F_None);
+	if (ec)
+		throw jlm::error("Cannot open file " + fp.to_str() + ": " + ec.message());
+
+	llvm::WriteBitcodeToFile(*llvm_module, os);
+}
+
 static void
 print(
 	const jlm::rvsdg_module & rm,
@@ -96,27 +187,102 @@ print(
 	> formatters({
 		{outputformat::xml,  print_as_xml}
 	, {outputformat::llvm, print_as_llvm}
+	, {outputformat::bc,   print_as_bc}
 	});
 
 	JLM_DEBUG_ASSERT(formatters.find(format) != formatters.end());
+	jlm::trace_scope scope("phase", "print");
 	formatters[format](rm, fp, sd);
 }
 
+static void
+process(
+	const char * executable,
+	const jlm::filepath & ifile,
+	const jlm::filepath & ofile,
+	const jlm::cmdline_options & flags)
+{
+	jlm::trace_scope scope("module", ifile.to_str());
+	module_stat stat(ifile, ofile);
+	stat.start();
+
+	llvm::LLVMContext ctx;
+	std::unique_ptr<llvm::Module> llvm_module;
+	{
+		jlm::trace_scope scope("phase", "parse");
+		llvm_module = parse_llvm_file(executable, ifile, ctx);
+	}
+
+	std::unique_ptr<jlm::ipgraph_module> jlm_module;
+	{
+		jlm::trace_scope scope("phase", "llvm2jlm");
+		jlm_module = construct_jlm_module(*llvm_module);
+	}
+
+	std::unique_ptr<jlm::rvsdg_module> rm;
+	{
+		std::lock_guard<std::mutex> guard(rvsdg_mutex);
+		{
+			jlm::trace_scope scope("phase", "jlm2rvsdg");
+			rm = jlm::construct_rvsdg(*jlm_module, flags.sd, flags.nthreads);
+		}
+
+		{
+			jlm::trace_scope scope("phase", "optimize");
+			optimize(*rm, flags.sd, *flags.pipeline);
+		}
+	}
+
+	print(*rm, ofile, flags.format, flags.sd);
+
+	{
+		std::lock_guard<std::mutex> guard(rvsdg_mutex);
+		rm.reset();
+	}
+
+	stat.end();
+	if (flags.sd.is_enabled(jlm::statid::module))
+		flags.sd.print_stat(stat);
+}
+
 int
 main(int argc, char ** argv)
 {
 	jlm::cmdline_options flags;
 	parse_cmdline(argc, argv, flags);
 
-	llvm::LLVMContext ctx;
-	auto llvm_module = parse_llvm_file(argv[0], flags.ifile, ctx);
-	auto jlm_module = construct_jlm_module(*llvm_module);
+	if (!flags.tfile.to_str().empty())
+		jlm::tracer::global().enable();
 
-	auto rm = jlm::construct_rvsdg(*jlm_module, flags.sd);
+	if (flags.batch.empty()) {
+		try {
+			process(argv[0], flags.ifile, flags.ofile, flags);
+		} catch (jlm::error & e) {
+			std::cerr << e.what() << "\n";
+			exit(EXIT_FAILURE);
+		}
+	} else {
+		/*
+			A failing module does not abort the batch. All other modules are
+			still processed, and the failure is reported in the exit status.
+		*/
+		std::atomic<bool> failed(false);
+		jlm::parallel_for(flags.batch.size(), flags.njobs, [&](size_t n)
+		{
+			try {
+				process(argv[0], flags.batch[n].first, flags.batch[n].second, flags);
+			} catch (jlm::error & e) {
+				std::cerr << e.what() << "\n";
+				failed = true;
+			}
+		});
 
-	optimize(*rm, flags.sd, flags.optimizations);
+		if (failed)
+			exit(EXIT_FAILURE);
+	}
 
-	print(*rm, flags.ofile, flags.format, flags.sd);
+	if (!flags.tfile.to_str().empty())
+		jlm::tracer::global().write(flags.tfile);
 
 	return 0;
 }
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_JLC_CACHE_HPP
+#define JLM_JLC_CACHE_HPP
+
+#include <jlm/util/file.hpp>
+
+#include <string>
+
+namespace jlm {
+
+/**
+* \brief Returns the SHA-1 digest of \p data as hexadecimal string.
+*/
+std::string
+sha1(const std::string & data);
+
+/**
+* \brief A content-addressed cache of object files.
+*
+* Every entry is stored in a file of the cache directory named after its key.
+* Entries are inserted and looked up atomically such that concurrent
+* compilations can share a cache directory.
+*/
+class objcache final {
+public:
+	objcache(const jlm::filepath & dir)
+	: dir_(dir)
+	{}
+
+	const jlm::filepath &
+	dir() const noexcept
+	{
+		return dir_;
+	}
+
+	jlm::filepath
+	path(const std::string & key) const;
+
+	/**
+	* \brief Copies the entry with key \p key to \p ofile.
+	*
+	* Returns false if there is no entry with key \p key. \p ofile is either
+	* completely written or left untouched.
+	*/
+	bool
+	lookup(const std::string & key, const jlm::filepath & ofile) const;
+
+	/**
+	* \brief Inserts \p ofile with key \p key into the cache.
+	*
+	* Throws jlm::error if the entry cannot be written.
+	*/
+	void
+	insert(const std::string & key, const jlm::filepath & ofile) const;
+
+private:
+	jlm::filepath dir_;
+};
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 #define JLM_JLC_CMDLINE_HPP
 
 #include <jlm/util/file.hpp>
+#include <jlm/util/stats.hpp>
 
 #include <string>
 #include <vector>
@@ -94,16 +95,23 @@ private:
 class cmdline_options {
 public:
 	cmdline_options()
-	: only_print_commands(false)
+	: in_process(false)
+	, only_print_commands(false)
 	, generate_debug_information(false)
+	, njobs(1)
+	, cachedir("")
 	, Olvl(optlvl::O0)
 	, std(standard::none)
 	, lnkofile("a.out")
 	{}
 
+	bool in_process;
 	bool only_print_commands;
 	bool generate_debug_information;
 
+	size_t njobs;
+	jlm::filepath cachedir;
+	stats_descriptor sd;
 	optlvl Olvl;
 	standard std;
 	jlm::filepath lnkofile;
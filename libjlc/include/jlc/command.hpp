@@ -6,6 +6,7 @@
 #ifndef JLM_JLC_COMMAND_HPP
 #define JLM_JLC_COMMAND_HPP
 
+#include <jlc/cache.hpp>
 #include <jlc/cmdline.hpp>
 #include <jlm/driver/passgraph.hpp>
 
@@ -72,10 +73,19 @@ public:
 	virtual
 	~optcmd();
 
-	optcmd(const jlm::filepath & ifile)
-	: ifile_(ifile)
+	optcmd(
+		const jlm::filepath & ifile,
+		const optlvl & ol)
+	: ol_(ol)
+	, ifile_(ifile)
 	{}
 
+	const optlvl &
+	optlevel() const noexcept
+	{
+		return ol_;
+	}
+
 	virtual std::string
 	to_str() const override;
 
@@ -85,12 +95,14 @@ public:
 	static passgraph_node *
 	create(
 		passgraph * pgraph,
-		const jlm::filepath & ifile)
+		const jlm::filepath & ifile,
+		const optlvl & ol)
 	{
-		return passgraph_node::create(pgraph, std::make_unique<optcmd>(ifile));
+		return passgraph_node::create(pgraph, std::make_unique<optcmd>(ifile, ol));
 	}
 
 private:
+	optlvl ol_;
 	jlm::filepath ifile_;
 };
 
@@ -138,6 +150,68 @@ private:
 	jlm::filepath ofile_;
 };
 
+/* in-process optimization and code generator command */
+
+/**
+* \brief Optimizes and compiles the output of the parser command within jlc.
+*
+* The command performs the work of an optcmd followed by a cgencmd, but it
+* keeps the LLVM module in memory. This avoids launching jlm-opt and llc as
+* well as printing and reparsing the optimized module. The stats of the
+* translation and optimization passes are written to \p sd.
+*/
+class optcgencmd final : public command {
+public:
+	virtual
+	~optcgencmd();
+
+	optcgencmd(
+		const jlm::filepath & ifile,
+		const jlm::filepath & ofile,
+		const optlvl & ol,
+		const stats_descriptor & sd)
+	: ol_(ol)
+	, ifile_(ifile)
+	, ofile_(ofile)
+	, sd_(sd)
+	{}
+
+	const optlvl &
+	optlevel() const noexcept
+	{
+		return ol_;
+	}
+
+	inline const jlm::filepath &
+	ofile() const noexcept
+	{
+		return ofile_;
+	}
+
+	virtual std::string
+	to_str() const override;
+
+	virtual void
+	run() const override;
+
+	static passgraph_node *
+	create(
+		passgraph * pgraph,
+		const jlm::filepath & ifile,
+		const jlm::filepath & ofile,
+		const optlvl & ol,
+		const stats_descriptor & sd)
+	{
+		return passgraph_node::create(pgraph, std::make_unique<optcgencmd>(ifile, ofile, ol, sd));
+	}
+
+private:
+	optlvl ol_;
+	jlm::filepath ifile_;
+	jlm::filepath ofile_;
+	const stats_descriptor & sd_;
+};
+
 /* linker command */
 
 class lnkcmd final : public command {
@@ -193,6 +267,110 @@ private:
 	std::vector<std::string> Lpaths_;
 };
 
+/* cache command */
+
+/**
+* \brief Runs the commands of a compilation unless its object file is cached.
+*
+* The cache key is a hash of the preprocessed input file, the compilation
+* flags, the paths of the LLVM tools, and the jlm version. On a cache miss,
+* the commands of the pass graph \p pgraph are run and their object file is
+* inserted into the cache.
+*/
+class cachecmd final : public command {
+public:
+	virtual
+	~cachecmd();
+
+	cachecmd(
+		std::unique_ptr<passgraph> pgraph,
+		const objcache & cache,
+		const jlm::filepath & ifile,
+		const jlm::filepath & ofile,
+		const std::vector<std::string> & Ipaths,
+		const std::vector<std::string> & Dmacros,
+		const standard & std,
+		const optlvl & ol,
+		bool in_process,
+		const stats_descriptor & sd)
+	: ol_(ol)
+	, std_(std)
+	, in_process_(in_process)
+	, cache_(cache)
+	, ifile_(ifile)
+	, ofile_(ofile)
+	, sd_(sd)
+	, Ipaths_(Ipaths)
+	, Dmacros_(Dmacros)
+	, pgraph_(std::move(pgraph))
+	{}
+
+	cachecmd(const cachecmd&) = delete;
+
+	cachecmd &
+	operator=(const cachecmd&) = delete;
+
+	const passgraph &
+	pgraph() const noexcept
+	{
+		return *pgraph_;
+	}
+
+	inline const jlm::filepath &
+	ofile() const noexcept
+	{
+		return ofile_;
+	}
+
+	/**
+	* \brief Returns the cache key of the compilation.
+	*
+	* Preprocesses the input file. The key includes the build identities of
+	* the jlm and LLVM executables that generate the object file. Returns an
+	* empty string if the preprocessed file cannot be read, in which case the
+	* compilation bypasses the cache.
+	*/
+	std::string
+	key() const;
+
+	virtual std::string
+	to_str() const override;
+
+	virtual void
+	run() const override;
+
+	static passgraph_node *
+	create(
+		passgraph * pgraph,
+		std::unique_ptr<passgraph> pg,
+		const objcache & cache,
+		const jlm::filepath & ifile,
+		const jlm::filepath & ofile,
+		const std::vector<std::string> & Ipaths,
+		const std::vector<std::string> & Dmacros,
+		const standard & std,
+		const optlvl & ol,
+		bool in_process,
+		const stats_descriptor & sd)
+	{
+		std::unique_ptr<cachecmd> cmd(new cachecmd(std::move(pg), cache, ifile, ofile, Ipaths,
+			Dmacros, std, ol, in_process, sd));
+		return passgraph_node::create(pgraph, std::move(cmd));
+	}
+
+private:
+	optlvl ol_;
+	standard std_;
+	bool in_process_;
+	objcache cache_;
+	jlm::filepath ifile_;
+	jlm::filepath ofile_;
+	const stats_descriptor & sd_;
+	std::vector<std::string> Ipaths_;
+	std::vector<std::string> Dmacros_;
+	std::unique_ptr<passgraph> pgraph_;
+};
+
 /* print command */
 
 class printcmd final : public command {
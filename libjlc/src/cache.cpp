@@ -0,0 +1,86 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlc/cache.hpp>
+
+#include <jlm/common.hpp>
+#include <jlm/util/strfmt.hpp>
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/SHA1.h>
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <thread>
+
+namespace jlm {
+
+/* SHA-1 */
+
+std::string
+sha1(const std::string & data)
+{
+	llvm::SHA1 sha1;
+	sha1.update(data);
+	return llvm::toHex(sha1.final(), true);
+}
+
+/* object cache */
+
+static bool
+copy(const jlm::filepath & from, const jlm::filepath & to)
+{
+	std::ifstream ifs(from.to_str(), std::ios::binary);
+	if (!ifs)
+		return false;
+
+	std::ofstream ofs(to.to_str(), std::ios::binary | std::ios::trunc);
+	ofs << ifs.rdbuf();
+	return ofs.good();
+}
+
+/*
+	Copies \p from to a unique temporary file next to \p to, and renames it
+	afterwards. Other processes and threads therefore never see a partially
+	written \p to.
+*/
+static bool
+copy_atomically(const jlm::filepath & from, const jlm::filepath & to)
+{
+	auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+	jlm::filepath tmp(strfmt(to.to_str(), ".", getpid(), ".", tid, ".tmp"));
+	if (!copy(from, tmp) || rename(tmp.to_str().c_str(), to.to_str().c_str())) {
+		unlink(tmp.to_str().c_str());
+		return false;
+	}
+
+	return true;
+}
+
+jlm::filepath
+objcache::path(const std::string & key) const
+{
+	return dir_.to_str() + "/" + key + ".o";
+}
+
+bool
+objcache::lookup(const std::string & key, const jlm::filepath & ofile) const
+{
+	return copy_atomically(path(key), ofile);
+}
+
+void
+objcache::insert(const std::string & key, const jlm::filepath & ofile) const
+{
+	mkdir(dir_.to_str().c_str(), 0755);
+
+	if (!copy_atomically(ofile, path(key)))
+		throw jlm::error("Cannot insert " + ofile.to_str() + " into cache " + dir_.to_str());
+}
+
+}
@@ -8,6 +8,7 @@
 
 #include <llvm/Support/CommandLine.h>
 
+#include <algorithm>
 #include <iostream>
 #include <unordered_map>
 
@@ -79,6 +80,35 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & flags)
 	, cl::ValueDisallowed
 	, cl::desc("Print (but do not run) the commands for this compilation."));
 
+	cl::opt<bool> in_process(
+	  "in-process"
+	, cl::ValueDisallowed
+	, cl::desc("Optimize and generate code within jlc instead of invoking jlm-opt and llc."));
+
+	cl::opt<size_t> njobs(
+	  "j"
+	, cl::Prefix
+	, cl::init(1)
+	, cl::desc("Run up to <n> commands concurrently.")
+	, cl::value_desc("n"));
+
+	cl::opt<std::string> cachedir(
+	  "cache"
+	, cl::desc("Cache object files in directory <dir>.")
+	, cl::value_desc("dir"));
+
+	cl::list<std::string> stats(
+	  "stats"
+	, cl::CommaSeparated
+	, cl::desc("Write the stats of <stat,...> to the stats file, e.g., cache.")
+	, cl::value_desc("stat,..."));
+
+	std::string statsdesc("Write stats to <file>. Default is " + flags.sd.filepath().to_str() + ".");
+	cl::opt<std::string> sfile(
+	  "stats-file"
+	, cl::desc(statsdesc)
+	, cl::value_desc("file"));
+
 	cl::list<std::string> ifiles(
 	  cl::Positional
 	, cl::desc("<inputs>"));
@@ -177,6 +207,17 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & flags)
 		flags.std = stdit->second;
 	}
 
+	try {
+		if (!sfile.empty())
+			flags.sd.set_file(sfile);
+
+		for (const auto & stat : stats)
+			flags.sd.enable(to_statid(stat));
+	} catch (jlm::error & e) {
+		std::cerr << "jlc: " << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+
 	if (ifiles.empty()) {
 		std::cerr << "jlc: no input files.\n";
 		exit(EXIT_FAILURE);
@@ -192,6 +233,9 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & flags)
 	flags.libpaths = libpaths;
 	flags.warnings = Wwarnings;
 	flags.includepaths = includepaths;
+	flags.njobs = std::max(size_t(1), size_t(njobs));
+	flags.cachedir = cachedir;
+	flags.in_process = in_process;
 	flags.only_print_commands = print_commands;
 	flags.generate_debug_information = generate_debug_information;
 
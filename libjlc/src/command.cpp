@@ -5,12 +5,43 @@
 
 #include <jlc/command.hpp>
 #include <jlc/llvmpaths.hpp>
-#include <jlm/util/strfmt.hpp>
 
+#include <jlm/common.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/jlm2llvm/jlm2llvm.hpp>
+#include <jlm/jlm2rvsdg/module.hpp>
+#include <jlm/llvm2jlm/module.hpp>
+#include <jlm/opt/optimization.hpp>
+#include <jlm/rvsdg2jlm/rvsdg2jlm.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/time.hpp>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/Program.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Target/TargetOptions.h>
+
+#include <chrono>
 #include <deque>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 
 namespace jlm {
 
@@ -23,25 +54,48 @@ generate_commands(const jlm::cmdline_options & opts)
 
 	std::vector<passgraph_node*> leaves;
 	for (const auto & c : opts.compilations) {
-		passgraph_node * last = pgraph->entry();
+		/*
+			The commands of a compilation are put in their own pass graph
+			if its object file can be cached.
+		*/
+		std::unique_ptr<passgraph> cgraph;
+		if (!opts.cachedir.to_str().empty() && c.parse() && c.optimize() && c.assemble())
+			cgraph.reset(new passgraph());
+
+		auto graph = cgraph ? cgraph.get() : pgraph.get();
+		passgraph_node * last = graph->entry();
 
 		if (c.parse()) {
-			auto prsnode = prscmd::create(pgraph.get(), c.ifile(), opts.includepaths, opts.macros,
+			auto prsnode = prscmd::create(graph, c.ifile(), opts.includepaths, opts.macros,
 				opts.warnings, opts.std);
 			last->add_edge(prsnode);
 			last = prsnode;
 		}
 
-		if (c.optimize()) {
-			auto optnode = optcmd::create(pgraph.get(), c.ifile());
-			last->add_edge(optnode);
-			last = optnode;
+		if (c.optimize() && c.assemble() && opts.in_process) {
+			auto node = optcgencmd::create(graph, c.ifile(), c.ofile(), opts.Olvl, opts.sd);
+			last->add_edge(node);
+			last = node;
+		} else {
+			if (c.optimize()) {
+				auto optnode = optcmd::create(graph, c.ifile(), opts.Olvl);
+				last->add_edge(optnode);
+				last = optnode;
+			}
+
+			if (c.assemble()) {
+				auto asmnode = cgencmd::create(graph, c.ifile(), c.ofile(), opts.Olvl);
+				last->add_edge(asmnode);
+				last = asmnode;
+			}
 		}
 
-		if (c.assemble()) {
-			auto asmnode = cgencmd::create(pgraph.get(), c.ifile(), c.ofile(), opts.Olvl);
-			last->add_edge(asmnode);
-			last = asmnode;
+		if (cgraph) {
+			last->add_edge(cgraph->exit());
+			last = cachecmd::create(pgraph.get(), std::move(cgraph), objcache(opts.cachedir),
+				c.ifile(), c.ofile(), opts.includepaths, opts.macros, opts.std, opts.Olvl,
+				opts.in_process, opts.sd);
+			pgraph->entry()->add_edge(last);
 		}
 
 		leaves.push_back(last);
@@ -77,12 +131,19 @@ generate_commands(const jlm::cmdline_options & opts)
 	return pgraph;
 }
 
+static void
+execute(const std::string & cmd)
+{
+	if (system(cmd.c_str()))
+		throw jlm::error("Command failed: " + cmd);
+}
+
 /* parser command */
 
 static std::string
 create_prscmd_ofile(const std::string & ifile)
 {
-	return strfmt("tmp-", ifile, "-clang-out.ll");
+	return strfmt("tmp-", ifile, "-clang-out.bc");
 }
 
 prscmd::~prscmd()
@@ -111,7 +172,7 @@ prscmd::to_str() const
 	, std_ != standard::none ? "-std="+jlm::to_str(std_)+" " : ""
 	, Dmacros, " "
 	, Ipaths, " "
-	, "-S -emit-llvm "
+	, "-c -emit-llvm "
 	, "-o /tmp/", create_prscmd_ofile(f), " "
 	, ifile_.to_str()
 	);
@@ -120,8 +181,7 @@ prscmd::to_str() const
 void
 prscmd::run() const
 {
-	if (system(to_str().c_str()))
-		exit(EXIT_FAILURE);
+	execute(to_str());
 }
 
 /* optimization command */
@@ -129,7 +189,7 @@ prscmd::run() const
 static std::string
 create_optcmd_ofile(const std::string & ifile)
 {
-	return strfmt("tmp-", ifile, "-jlm-opt-out.ll");
+	return strfmt("tmp-", ifile, "-jlm-opt-out.bc");
 }
 
 optcmd::~optcmd()
@@ -142,16 +202,17 @@ optcmd::to_str() const
 
 	return strfmt(
 	  "jlm-opt "
-	, "--llvm "
-	, "/tmp/", create_prscmd_ofile(f), " > /tmp/", create_optcmd_ofile(f)
+	, "--bc "
+	, "-", jlm::to_str(ol_), " "
+	, "-o /tmp/", create_optcmd_ofile(f), " "
+	, "/tmp/", create_prscmd_ofile(f)
 	);
 }
 
 void
 optcmd::run() const
 {
-	if (system(to_str().c_str()))
-		exit(EXIT_FAILURE);
+	execute(to_str());
 }
 
 /* code generator command */
@@ -174,8 +235,123 @@ cgencmd::to_str() const
 void
 cgencmd::run() const
 {
-	if (system(to_str().c_str()))
-		exit(EXIT_FAILURE);
+	execute(to_str());
+}
+
+/* in-process optimization and code generator command */
+
+static size_t
+to_level(const optlvl & ol)
+{
+	static std::unordered_map<optlvl, size_t> map({
+	  {optlvl::O0, 0}, {optlvl::O1, 1}
+	, {optlvl::O2, 2}, {optlvl::O3, 3}
+	});
+
+	JLM_DEBUG_ASSERT(map.find(ol) != map.end());
+	return map[ol];
+}
+
+static llvm::CodeGenOpt::Level
+to_codegen_level(const optlvl & ol)
+{
+	static std::unordered_map<optlvl, llvm::CodeGenOpt::Level> map({
+	  {optlvl::O0, llvm::CodeGenOpt::None}, {optlvl::O1, llvm::CodeGenOpt::Less}
+	, {optlvl::O2, llvm::CodeGenOpt::Default}, {optlvl::O3, llvm::CodeGenOpt::Aggressive}
+	});
+
+	JLM_DEBUG_ASSERT(map.find(ol) != map.end());
+	return map[ol];
+}
+
+static void
+emit_object(llvm::Module & module, const jlm::filepath & ofile, const optlvl & ol)
+{
+	static std::once_flag initialized;
+	std::call_once(initialized, []()
+	{
+		llvm::InitializeNativeTarget();
+		llvm::InitializeNativeTargetAsmPrinter();
+	});
+
+	auto triple = module.getTargetTriple();
+	if (triple.empty())
+		triple = llvm::sys::getDefaultTargetTriple();
+
+	std::string error;
+	auto target = llvm::TargetRegistry::lookupTarget(triple, error);
+	if (!target)
+		throw jlm::error(error);
+
+	/*
+		The out-of-process path invokes llc without -mcpu and -mattr, which
+		selects the default CPU and features of the target. Do the same here
+		such that both paths emit the same code.
+	*/
+	std::unique_ptr<llvm::TargetMachine> tm(target->createTargetMachine(triple, "", "",
+		llvm::TargetOptions(), llvm::None, llvm::None, to_codegen_level(ol)));
+	module.setDataLayout(tm->createDataLayout());
+
+	std::error_code ec;
+	llvm::raw_fd_ostream os(ofile.to_str(), ec, llvm::sys::fs::F_None);
+	if (ec)
+		throw jlm::error("Cannot open file " + ofile.to_str() + ": " + ec.message());
+
+	llvm::legacy::PassManager pm;
+	if (tm->addPassesToEmitFile(pm, os, nullptr, llvm::TargetMachine::CGFT_ObjectFile))
+		throw jlm::error("Cannot emit object files for target " + triple);
+
+	pm.run(module);
+}
+
+optcgencmd::~optcgencmd()
+{}
+
+std::string
+optcgencmd::to_str() const
+{
+	return strfmt(
+	  "jlc --in-process "
+	, "-", jlm::to_str(ol_), " "
+	, "-o ", ofile_.to_str()
+	, " /tmp/", create_prscmd_ofile(ifile_.base())
+	);
+}
+
+void
+optcgencmd::run() const
+{
+	auto ifile = strfmt("/tmp/", create_prscmd_ofile(ifile_.base()));
+
+	llvm::LLVMContext ctx;
+	llvm::SMDiagnostic d;
+	auto lm = llvm::parseIRFile(ifile, d, ctx);
+	if (!lm) {
+		std::string msg;
+		llvm::raw_string_ostream os(msg);
+		d.print("jlc", os);
+		throw jlm::error(os.str());
+	}
+
+	std::unique_ptr<llvm::Module> olm;
+	{
+		/*
+			FIXME: The RVSDG library keeps global state, e.g., its node
+			notifiers. We therefore only translate and optimize one module at
+			a time, even if commands are run concurrently.
+		*/
+		static std::mutex mutex;
+		std::lock_guard<std::mutex> guard(mutex);
+
+		auto im = convert_module(*lm);
+		auto rm = construct_rvsdg(*im, sd_);
+		optimize(*rm, sd_, *create_pipeline(to_level(ol_)));
+
+		auto om = rvsdg2jlm::rvsdg2jlm(*rm, sd_);
+		olm = jlm2llvm::convert(*om, ctx);
+	}
+
+	emit_object(*olm, ofile_, ol_);
 }
 
 /* linker command */
@@ -211,8 +387,177 @@ lnkcmd::to_str() const
 void
 lnkcmd::run() const
 {
-	if (system(to_str().c_str()))
-		exit(EXIT_FAILURE);
+	execute(to_str());
+}
+
+/* cache command */
+
+/*
+	Returns the build identity of the executable at path. Like ccache, the
+	executable is identified by its size and modification time instead of a
+	hash of its contents, as hashing executables that link LLVM would cost
+	more than most cache hits save.
+*/
+static std::string
+build_id(const std::string & path)
+{
+	llvm::sys::fs::file_status status;
+	if (llvm::sys::fs::status(path, status))
+		throw jlm::error("Cannot stat " + path);
+
+	auto mtime = status.getLastModificationTime().time_since_epoch();
+	return strfmt(path, " ", status.getSize(), " ",
+		std::chrono::duration_cast<std::chrono::nanoseconds>(mtime).count());
+}
+
+/*
+	Returns the build identity of the jlm code that optimizes a compilation.
+	This is jlc itself for in-process compilations, and jlm-opt otherwise. If
+	the path of jlc cannot be determined on the host, the compilation time of
+	this file serves as identity instead.
+*/
+static std::string
+jlm_build_id(bool in_process)
+{
+	if (in_process) {
+		auto path = llvm::sys::fs::getMainExecutable(nullptr,
+			reinterpret_cast<void*>(&jlm_build_id));
+		return !path.empty() ? build_id(path) : strfmt("jlc ", __DATE__, " ", __TIME__);
+	}
+
+	auto path = llvm::sys::findProgramByName("jlm-opt");
+	if (!path)
+		throw jlm::error("Cannot find jlm-opt: " + path.getError().message());
+
+	return build_id(path.get());
+}
+
+class cache_stat final : public stat {
+public:
+	virtual
+	~cache_stat()
+	{}
+
+	cache_stat(const jlm::filepath & filename)
+	: stat(statid::cache)
+	, hit_(false)
+	, filename_(filename)
+	{}
+
+	void
+	start() noexcept
+	{
+		timer_.start();
+	}
+
+	void
+	end(bool hit) noexcept
+	{
+		timer_.stop();
+		hit_ = hit;
+	}
+
+	virtual std::vector<statfield>
+	fields() const override
+	{
+		return {
+		  {"file", filename_.to_str()}
+		, {"hits", size_t(hit_)}, {"misses", size_t(!hit_)}
+		, {"time_ns", timer_.ns()}
+		};
+	}
+
+private:
+	bool hit_;
+	jlm::timer timer_;
+	jlm::filepath filename_;
+};
+
+cachecmd::~cachecmd()
+{}
+
+std::string
+cachecmd::key() const
+{
+	std::string Ipaths;
+	for (const auto & Ipath : Ipaths_)
+		Ipaths += "-I" + Ipath + " ";
+
+	std::string Dmacros;
+	for (const auto & Dmacro : Dmacros_)
+		Dmacros += "-D" + Dmacro + " ";
+
+	/*
+		Preprocess into a unique file, as the same input file might be
+		compiled concurrently, e.g., with make -j. A failure only bypasses the
+		cache. The compilation itself reports the errors of the input file.
+	*/
+	llvm::SmallString<128> ppfile;
+	if (llvm::sys::fs::createTemporaryFile("jlc-" + ifile_.base(), "i", ppfile))
+		return "";
+
+	auto cmd = strfmt(
+	  clangpath.to_str() + " "
+	, std_ != standard::none ? "-std="+jlm::to_str(std_)+" " : ""
+	, Dmacros, " "
+	, Ipaths, " "
+	, "-E "
+	, "-o ", ppfile.str().str(), " "
+	, ifile_.to_str()
+	);
+
+	std::stringstream pp;
+	bool read = false;
+	if (system(cmd.c_str()) == 0) {
+		std::ifstream ifs(ppfile.c_str());
+		read = ifs && (pp << ifs.rdbuf());
+	}
+	llvm::sys::fs::remove(ppfile);
+	if (!read)
+		return "";
+
+	return sha1(strfmt(
+	  jlm_build_id(in_process_), "\n"
+	, in_process_ ? "in-process" : "out-of-process", "\n"
+	, build_id(clangpath.to_str()), "\n"
+	, in_process_ ? "" : build_id(llcpath.to_str()), "\n"
+	, jlm::to_str(ol_), "\n"
+	, jlm::to_str(std_), "\n"
+	, Dmacros, "\n"
+	, Ipaths, "\n"
+	, pp.str()
+	));
+}
+
+std::string
+cachecmd::to_str() const
+{
+	std::string str;
+	for (const auto & node : topsort(pgraph_.get())) {
+		if (node != pgraph_->entry() && node != pgraph_->exit())
+			str += (str.empty() ? "" : "\n") + node->cmd().to_str();
+	}
+
+	return str;
+}
+
+void
+cachecmd::run() const
+{
+	cache_stat stat(ifile_);
+	stat.start();
+
+	auto k = key();
+	auto hit = !k.empty() && cache_.lookup(k, ofile_);
+	if (!hit) {
+		pgraph_->run();
+		if (!k.empty())
+			cache_.insert(k, ofile_);
+	}
+
+	stat.end(hit);
+	if (sd_.is_enabled(statid::cache))
+		sd_.print_stat(stat);
 }
 
 /* print command */
@@ -6,6 +6,8 @@
 #include <jlc/cmdline.hpp>
 #include <jlc/command.hpp>
 
+#include <jlm/common.hpp>
+
 #include <iostream>
 
 int
@@ -15,7 +17,12 @@ main(int argc, char ** argv)
 	parse_cmdline(argc, argv, options);
 
 	auto pgraph = generate_commands(options);
-	pgraph->run();
+	try {
+		pgraph->run(options.njobs);
+	} catch (jlm::error & e) {
+		std::cerr << "jlc: " << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
 
 	return 0;
 }
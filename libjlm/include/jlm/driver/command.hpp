@@ -20,6 +20,11 @@ public:
 	virtual std::string
 	to_str() const = 0;
 
+	/**
+	* \brief Runs the command.
+	*
+	* Throws jlm::error if the command fails.
+	*/
 	virtual void
 	run() const = 0;
 };
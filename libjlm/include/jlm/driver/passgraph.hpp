@@ -268,8 +268,16 @@ public:
 		nodes_.insert(std::move(node));
 	}
 
+	/**
+	* \brief Runs all commands of the pass graph.
+	*
+	* A command is run once all its predecessors finished. Up to \p njobs
+	* commands are run concurrently. If a command throws, no further commands
+	* are started and the exception is rethrown once all running commands
+	* finished.
+	*/
 	void
-	run() const;
+	run(size_t njobs = 1) const;
 
 private:
 	passgraph_node * exit_;
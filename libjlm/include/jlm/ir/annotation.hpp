@@ -6,30 +6,38 @@
 #ifndef JLM_IR_ANNOTATION_HPP
 #define JLM_IR_ANNOTATION_HPP
 
+#include <jlm/ir/dataflow.hpp>
+
 #include <memory>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace jlm {
 
 class aggnode;
-class variable;
-
-typedef std::unordered_set<const jlm::variable*> variableset;
 
+/**
+* \brief The variables demanded by an aggregation node.
+*
+* All demand sets of an annotation share the same variable index.
+*/
 class demandset {
 public:
 	virtual
 	~demandset();
 
 	inline
-	demandset()
+	demandset(std::shared_ptr<variableindex> index)
+	: top(*index)
+	, bottom(*index)
+	, reads(*index)
+	, writes(*index)
+	, index_(std::move(index))
 	{}
 
 	static inline std::unique_ptr<demandset>
-	create()
+	create(std::shared_ptr<variableindex> index)
 	{
-		return std::make_unique<demandset>();
+		return std::make_unique<demandset>(std::move(index));
 	}
 
 	variableset top;
@@ -37,6 +45,9 @@ public:
 
 	variableset reads;
 	variableset writes;
+
+private:
+	std::shared_ptr<variableindex> index_;
 };
 
 typedef std::unordered_map<const aggnode*, std::unique_ptr<demandset>> demandmap;
@@ -110,6 +110,7 @@ public:
 	jlm::tac *
 	append_first(std::unique_ptr<jlm::tac> tac)
 	{
+		intern(tac.get());
 		tacs_.append_first(std::move(tac));
 		return tacs_.first();
 	}
@@ -125,12 +126,15 @@ public:
 	void
 	append_first(taclist & tl)
 	{
+		for (const auto & tac : tl)
+			intern(tac);
 		tacs_.append_first(tl);
 	}
 
 	jlm::tac *
 	append_last(std::unique_ptr<jlm::tac> tac)
 	{
+		intern(tac.get());
 		tacs_.append_last(std::move(tac));
 		return tacs_.last();
 	}
@@ -148,6 +152,7 @@ public:
 		const taclist::const_iterator & it,
 		std::unique_ptr<jlm::tac> tac)
 	{
+		intern(tac.get());
 		return tacs_.insert_before(it, std::move(tac));
 	}
 
@@ -157,7 +162,7 @@ public:
 		tacsvector_t & tv)
 	{
 		for (auto & tac : tv)
-			tacs_.insert_before(it, std::move(tac));
+			insert_before(it, std::move(tac));
 		tv.clear();
 	}
 
@@ -168,6 +173,12 @@ public:
 	create(jlm::cfg & cfg);
 
 private:
+	/*
+		Shares the operation of a tac with all equal tacs of the module.
+	*/
+	void
+	intern(jlm::tac * tac);
+
 	taclist tacs_;
 };
 
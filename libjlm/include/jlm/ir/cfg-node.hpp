@@ -7,10 +7,10 @@
 #define JLM_IR_CFG_NODE_H
 
 #include <jlm/common.hpp>
+#include <jlm/util/small-vector.hpp>
 
 #include <memory>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 
@@ -20,10 +20,14 @@ class basic_block;
 class cfg;
 class cfg_node;
 
+/**
+* \brief An edge of a control flow graph.
+*
+* Edges are allocated from a pool of their cfg and are only created and
+* destroyed through cfg_node::add_outedge() and cfg_node::remove_outedge().
+*/
 class cfg_edge final {
 public:
-	~cfg_edge() noexcept {};
-
 	cfg_edge(cfg_node * source, cfg_node * sink, size_t index) noexcept;
 
 	void
@@ -47,13 +51,20 @@ private:
 };
 
 class cfg_node {
-	typedef std::unordered_set<cfg_edge*>::iterator inedge_iterator;
-	typedef std::unordered_set<cfg_edge*>::const_iterator const_inedge_iterator;
+	/*
+		Most nodes have only one or two predecessors and successors. The edges
+		are therefore kept in small vectors that avoid heap allocations for
+		those nodes.
+	*/
+	typedef small_vector<cfg_edge*, 2> edgevector;
+
+	typedef edgevector::iterator inedge_iterator;
+	typedef edgevector::const_iterator const_inedge_iterator;
 
 	class const_outedge_iterator final {
 	public:
 		inline
-		const_outedge_iterator(const std::vector<std::unique_ptr<cfg_edge>>::const_iterator & it)
+		const_outedge_iterator(const edgevector::const_iterator & it)
 		: it_(it)
 		{}
 
@@ -93,11 +104,11 @@ class cfg_node {
 		inline cfg_edge *
 		edge() const noexcept
 		{
-			return it_->get();
+			return *it_;
 		}
 
 	private:
-		std::vector<std::unique_ptr<cfg_edge>>::const_iterator it_;
+		edgevector::const_iterator it_;
 	};
 
 public:
@@ -107,7 +118,8 @@ public:
 protected:
 	inline
 	cfg_node(jlm::cfg & cfg)
-	: cfg_(cfg)
+	: index_(0)
+	, cfg_(cfg)
 	{}
 
 public:
@@ -117,27 +129,25 @@ public:
 		return cfg_;
 	}
 
-	cfg_edge *
-	add_outedge(cfg_node * sink)
+	/**
+	* \brief Returns the index of the node in its cfg.
+	*
+	* Indices are dense and stable, i.e., they are not reused after a node is
+	* removed, until cfg::compact() renumbers the nodes. The entry node has
+	* index 0 and the exit node index 1. Analyses can use them to address side
+	* tables of size cfg::nindices().
+	*/
+	size_t
+	index() const noexcept
 	{
-		outedges_.push_back(std::make_unique<cfg_edge>(this, sink, noutedges()));
-		sink->inedges_.insert(outedges_.back().get());
-		return outedges_.back().get();
+		return index_;
 	}
 
-	inline void
-	remove_outedge(size_t n)
-	{
-		JLM_DEBUG_ASSERT(n < noutedges());
-		auto edge = outedges_[n].get();
+	cfg_edge *
+	add_outedge(cfg_node * sink);
 
-		edge->sink()->inedges_.erase(edge);
-		for (size_t i = n+1; i < noutedges(); i++) {
-			outedges_[i-1] = std::move(outedges_[i]);
-			outedges_[i-1]->index_ = outedges_[i-1]->index_-1;
-		}
-		outedges_.resize(noutedges()-1);
-	}
+	void
+	remove_outedge(size_t n);
 
 	inline void
 	remove_outedges()
@@ -150,7 +160,7 @@ public:
 	outedge(size_t n) const
 	{
 		JLM_DEBUG_ASSERT(n < noutedges());
-		return outedges_[n].get();
+		return outedges_[n];
 	}
 
 	size_t noutedges() const noexcept;
@@ -215,11 +225,16 @@ public:
 	bool has_selfloop_edge() const noexcept;
 
 private:
+	void
+	remove_inedge(cfg_edge * edge) noexcept;
+
+	size_t index_;
 	jlm::cfg & cfg_;
-	std::vector<std::unique_ptr<cfg_edge>> outedges_;
-	std::unordered_set<cfg_edge*> inedges_;
+	edgevector outedges_;
+	edgevector inedges_;
 
 	friend cfg_edge;
+	friend jlm::cfg;
 };
 
 template <class T> static inline bool
@@ -231,6 +246,29 @@ is(const cfg_node * node) noexcept
 	return dynamic_cast<const T*>(node) != nullptr;
 }
 
+/**
+* \brief Orders nodes by their index and edges by their source and index.
+*
+* Containers ordered by it are iterated in the same order for equal cfgs,
+* i.e., independent of the addresses of the nodes and edges.
+*/
+struct index_order final {
+	bool
+	operator()(const cfg_node * n1, const cfg_node * n2) const noexcept
+	{
+		return n1->index() < n2->index();
+	}
+
+	bool
+	operator()(const cfg_edge * e1, const cfg_edge * e2) const noexcept
+	{
+		if (e1->source() != e2->source())
+			return e1->source()->index() < e2->source()->index();
+
+		return e1->index() < e2->index();
+	}
+};
+
 }
 
 #endif
@@ -13,6 +13,7 @@ namespace jlm {
 
 class cfg;
 class cfg_node;
+class sccfinder;
 
 bool
 is_valid(const jlm::cfg & cfg);
@@ -23,6 +24,18 @@ is_closed(const jlm::cfg & cfg);
 bool
 is_linear(const jlm::cfg & cfg);
 
+/**
+* \brief Finds the SCCs of the nodes that are reachable from \p entry
+* without passing through \p exit.
+*
+* Single nodes are only considered to be an SCC if they have a self loop. The
+* SCCs are returned in reverse topological order. The scratch buffers of
+* \p finder are reused, such that repeated searches in regions of a large
+* cfg only cost time proportional to the size of the regions.
+*/
+std::vector<std::unordered_set<jlm::cfg_node*>>
+find_sccs(jlm::cfg_node * entry, jlm::cfg_node * exit, sccfinder & finder);
+
 std::vector<std::unordered_set<jlm::cfg_node*>>
 find_sccs(const jlm::cfg & cfg);
 
@@ -33,6 +46,58 @@ is_acyclic(const jlm::cfg & cfg)
 	return sccs.size() == 0;
 }
 
+/**
+* \brief The structural classification of a closed cfg.
+*
+* A cfg is structured if it can be reduced to a single node by repeatedly
+* reducing self loops, branches, and linear sequences of nodes. It is proper
+* structured if it can be reduced with branches whose alternatives all
+* consist of exactly one node. It is reducible if it can be reduced with the
+* T1 and T2 transformations, i.e., if all its nodes are reachable and every
+* cycle is entered through a node that dominates the cycle.
+*/
+class cfg_structure final {
+public:
+	cfg_structure(const jlm::cfg & cfg);
+
+	cfg_structure(const cfg_structure&) = delete;
+
+	cfg_structure &
+	operator=(const cfg_structure&) = delete;
+
+	bool
+	is_structured() const noexcept
+	{
+		return structured_;
+	}
+
+	bool
+	is_proper_structured() const noexcept
+	{
+		return proper_structured_;
+	}
+
+	bool
+	is_reducible() const noexcept
+	{
+		return reducible_;
+	}
+
+private:
+	bool reducible_;
+	bool structured_;
+	bool proper_structured_;
+};
+
+/**
+* \brief Returns the structural classification of \p cfg.
+*
+* The classification is computed on demand and cached in the cfg until its
+* nodes or edges are modified.
+*/
+const cfg_structure &
+structure(const jlm::cfg & cfg);
+
 bool
 is_structured(const jlm::cfg & cfg);
 
@@ -9,6 +9,7 @@
 #include <jlm/ir/basic-block.hpp>
 #include <jlm/ir/cfg-node.hpp>
 #include <jlm/ir/variable.hpp>
+#include <jlm/util/arena.hpp>
 
 #include <jive/types/function.h>
 #include <jive/rvsdg/operation.h>
@@ -23,6 +24,7 @@ namespace jlm {
 
 class clg_node;
 class basic_block;
+class cfg_structure;
 class ipgraph_module;
 class tac;
 
@@ -109,12 +111,20 @@ private:
 /* control flow graph */
 
 class cfg final {
+	typedef std::vector<std::unique_ptr<basic_block>>::const_iterator node_iterator;
+
+	/*
+		Removed nodes leave a null entry behind. The iterators skip them.
+	*/
 	class iterator final {
 	public:
 		inline
-		iterator(std::unordered_set<std::unique_ptr<basic_block>>::iterator it)
+		iterator(const node_iterator & it, const node_iterator & end)
 		: it_(it)
-		{}
+		, end_(end)
+		{
+			skip();
+		}
 
 		inline bool
 		operator==(const iterator & other) const noexcept
@@ -132,14 +142,15 @@ class cfg final {
 		operator++() noexcept
 		{
 			++it_;
+			skip();
 			return *this;
 		}
 
 		inline const iterator
 		operator++(int) noexcept
 		{
-			iterator tmp(it_);
-			it_++;
+			iterator tmp = *this;
+			++*this;
 			return tmp;
 		}
 
@@ -162,14 +173,22 @@ class cfg final {
 		}
 
 	private:
-		std::unordered_set<std::unique_ptr<basic_block>>::iterator it_;
+		inline void
+		skip() noexcept
+		{
+			while (it_ != end_ && *it_ == nullptr)
+				++it_;
+		}
+
+		node_iterator it_;
+		node_iterator end_;
 	};
 
 	class const_iterator final {
 	public:
 		inline
-		const_iterator(std::unordered_set<std::unique_ptr<basic_block>>::const_iterator it)
-		: it_(it)
+		const_iterator(const node_iterator & it, const node_iterator & end)
+		: it_(it, end)
 		{}
 
 		inline bool
@@ -194,29 +213,29 @@ class cfg final {
 		inline const const_iterator
 		operator++(int) noexcept
 		{
-			const_iterator tmp(it_);
-			it_++;
+			const_iterator tmp = *this;
+			++it_;
 			return tmp;
 		}
 
 		inline const basic_block &
 		operator*() noexcept
 		{
-			return *it_->get();
+			return *it_;
 		}
 
 		inline const basic_block *
 		operator->() noexcept
 		{
-			return it_->get();
+			return it_.node();
 		}
 
 	private:
-		std::unordered_set<std::unique_ptr<basic_block>>::const_iterator it_;
+		iterator it_;
 	};
 
 public:
-	~cfg() {}
+	~cfg();
 
 	cfg(ipgraph_module & im);
 
@@ -234,25 +253,25 @@ public:
 	inline const_iterator
 	begin() const
 	{
-		return const_iterator(nodes_.begin());
+		return const_iterator(nodes_.begin(), nodes_.end());
 	}
 
 	inline iterator
 	begin()
 	{
-		return iterator(nodes_.begin());
+		return iterator(nodes_.begin(), nodes_.end());
 	}
 
 	inline const_iterator
 	end() const
 	{
-		return const_iterator(nodes_.end());
+		return const_iterator(nodes_.end(), nodes_.end());
 	}
 
 	inline iterator
 	end()
 	{
-		return iterator(nodes_.end());
+		return iterator(nodes_.end(), nodes_.end());
 	}
 
 	inline jlm::entry_node *
@@ -267,22 +286,11 @@ public:
 		return exit_.get();
 	}
 
-	inline basic_block *
-	add_node(std::unique_ptr<basic_block> bb)
-	{
-		auto tmp = bb.get();
-		nodes_.insert(std::move(bb));
-		return tmp;
-	}
+	basic_block *
+	add_node(std::unique_ptr<basic_block> bb);
 
-	inline cfg::iterator
-	find_node(basic_block * bb)
-	{
-		std::unique_ptr<basic_block> up(bb);
-		auto it = nodes_.find(up);
-		up.release();
-		return iterator(it);
-	}
+	cfg::iterator
+	find_node(basic_block * bb);
 
 	cfg::iterator
 	remove_node(cfg::iterator & it);
@@ -297,12 +305,43 @@ public:
 		return remove_node(it);
 	}
 
+	/**
+	* \brief Reclaims the indices of removed nodes.
+	*
+	* Removed nodes leave an empty slot behind, such that the indices of all
+	* other nodes stay valid. The slots are only reclaimed by this function,
+	* which renumbers the basic blocks densely in their current order. All
+	* indices and side tables obtained before are invalidated.
+	*/
+	void
+	compact();
+
 	inline size_t
 	nnodes() const noexcept
 	{
-		return nodes_.size();
+		return nnodes_;
 	}
 
+	/**
+	* \brief Returns the number of node indices handed out so far.
+	*
+	* All node indices of the cfg, including the ones of the entry and exit
+	* node, are smaller than this number.
+	*/
+	inline size_t
+	nindices() const noexcept
+	{
+		return nodes_.size() + 2;
+	}
+
+	/**
+	* \brief Returns the node with index \p index.
+	*
+	* Returns null if the node was removed.
+	*/
+	cfg_node *
+	node(size_t index) const noexcept;
+
 	inline ipgraph_module &
 	module() const noexcept
 	{
@@ -330,10 +369,42 @@ public:
 	}
 
 private:
+	/*
+		Invoked whenever nodes or edges are added, removed, or diverted.
+	*/
+	void
+	invalidate_structure() noexcept;
+
+	cfg_edge *
+	create_edge(cfg_node * source, cfg_node * sink, size_t index);
+
+	void
+	destroy_edge(cfg_edge * edge);
+
+	/*
+		Edges are allocated from the edge pool. Removed edges are put on a free
+		list and reused by subsequently created edges.
+	*/
+	jlm::arena edgepool_;
+	std::vector<cfg_edge*> freeedges_;
+
+	size_t nnodes_;
 	ipgraph_module & module_;
 	std::unique_ptr<exit_node> exit_;
 	std::unique_ptr<entry_node> entry_;
-	std::unordered_set<std::unique_ptr<basic_block>> nodes_;
+	std::vector<std::unique_ptr<basic_block>> nodes_;
+
+	/*
+		The cached result of structure() in cfg-structure.hpp. It is not
+		thread-safe to query the structure of a cfg from several threads.
+	*/
+	mutable std::unique_ptr<cfg_structure> structure_;
+
+	friend cfg_edge;
+	friend cfg_node;
+
+	friend const cfg_structure &
+	structure(const jlm::cfg & cfg);
 };
 
 std::vector<cfg_node*>
@@ -0,0 +1,315 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_DATAFLOW_HPP
+#define JLM_IR_DATAFLOW_HPP
+
+#include <jlm/common.hpp>
+#include <jlm/util/bitvector.hpp>
+
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+namespace jlm {
+
+class cfg;
+class cfg_node;
+class taclist;
+class variable;
+
+/**
+* \brief Assigns dense indices to variables.
+*
+* The indices are handed out in order of insertion, starting from zero.
+*/
+class variableindex final {
+public:
+	/**
+	* \brief Returns the index of \p v. The variable is added if necessary.
+	*/
+	size_t
+	insert(const jlm::variable * v)
+	{
+		auto it = indices_.find(v);
+		if (it != indices_.end())
+			return it->second;
+
+		indices_[v] = variables_.size();
+		variables_.push_back(v);
+		return variables_.size()-1;
+	}
+
+	bool
+	contains(const jlm::variable * v) const noexcept
+	{
+		return indices_.find(v) != indices_.end();
+	}
+
+	size_t
+	index(const jlm::variable * v) const noexcept
+	{
+		JLM_DEBUG_ASSERT(contains(v));
+		return indices_.at(v);
+	}
+
+	const jlm::variable *
+	at(size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < size());
+		return variables_[index];
+	}
+
+	size_t
+	size() const noexcept
+	{
+		return variables_.size();
+	}
+
+private:
+	std::unordered_map<const jlm::variable*, size_t> indices_;
+	std::vector<const jlm::variable*> variables_;
+};
+
+/**
+* \brief A set of variables represented as bitvector over a variable index.
+*
+* The variables are iterated in order of their index. Sets can only be
+* combined with sets of the same index.
+*/
+class variableset final {
+public:
+	class const_iterator final {
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef const jlm::variable * value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const jlm::variable ** pointer;
+		typedef const jlm::variable * reference;
+
+		const_iterator(const variableindex * index, const bitvector::const_iterator & it)
+		: it_(it)
+		, index_(index)
+		{}
+
+		const jlm::variable *
+		operator*() const noexcept
+		{
+			return index_->at(*it_);
+		}
+
+		const_iterator &
+		operator++() noexcept
+		{
+			++it_;
+			return *this;
+		}
+
+		const_iterator
+		operator++(int) noexcept
+		{
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool
+		operator==(const const_iterator & other) const noexcept
+		{
+			return it_ == other.it_;
+		}
+
+		bool
+		operator!=(const const_iterator & other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+	private:
+		bitvector::const_iterator it_;
+		const variableindex * index_;
+	};
+
+	variableset(variableindex & index)
+	: index_(&index)
+	{}
+
+	variableset(variableindex & index, bitvector bits)
+	: index_(&index)
+	, bits_(std::move(bits))
+	{}
+
+	const_iterator
+	begin() const noexcept
+	{
+		return const_iterator(index_, bits_.begin());
+	}
+
+	const_iterator
+	end() const noexcept
+	{
+		return const_iterator(index_, bits_.end());
+	}
+
+	const bitvector &
+	bits() const noexcept
+	{
+		return bits_;
+	}
+
+	const variableindex &
+	index() const noexcept
+	{
+		return *index_;
+	}
+
+	size_t
+	size() const noexcept
+	{
+		return bits_.size();
+	}
+
+	bool
+	empty() const noexcept
+	{
+		return bits_.empty();
+	}
+
+	bool
+	contains(const jlm::variable * v) const noexcept
+	{
+		return index_->contains(v) && bits_.contains(index_->index(v));
+	}
+
+	void
+	insert(const jlm::variable * v)
+	{
+		bits_.insert(index_->insert(v));
+	}
+
+	void
+	erase(const jlm::variable * v) noexcept
+	{
+		if (index_->contains(v))
+			bits_.erase(index_->index(v));
+	}
+
+	variableset &
+	operator|=(const variableset & other)
+	{
+		JLM_DEBUG_ASSERT(index_ == other.index_);
+		bits_ |= other.bits_;
+		return *this;
+	}
+
+	variableset &
+	operator&=(const variableset & other)
+	{
+		JLM_DEBUG_ASSERT(index_ == other.index_);
+		bits_ &= other.bits_;
+		return *this;
+	}
+
+	variableset &
+	operator-=(const variableset & other)
+	{
+		JLM_DEBUG_ASSERT(index_ == other.index_);
+		bits_ -= other.bits_;
+		return *this;
+	}
+
+	bool
+	operator==(const variableset & other) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index_ == other.index_);
+		return bits_ == other.bits_;
+	}
+
+	bool
+	operator!=(const variableset & other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+private:
+	variableindex * index_;
+	bitvector bits_;
+};
+
+/**
+* \brief Computes the variables \p tacs reads before writing them and the
+* variables it writes.
+*
+* Assignments write their first operand. Phi operations only write their
+* result, since their operands are read at the end of the predecessors.
+*/
+void
+readwrite(const taclist & tacs, variableset & reads, variableset & writes);
+
+/**
+* \brief Solves a gen/kill dataflow problem over the nodes of a cfg.
+*
+* The sets of a node are addressed by its index. A forward problem computes
+* out(n) = gen(n) | (in(n) - kill(n)), where in(n) is the meet of the out sets
+* of all predecessors and in(entry) is the boundary set. A backward problem
+* computes in(n) = gen(n) | (out(n) - kill(n)), where out(n) is the meet of
+* the in sets of all successors and out(exit) is the boundary set. The nodes
+* are visited in reverse postorder, or postorder respectively, until a fixed
+* point is reached. The cfg must be closed.
+*/
+class dataflow final {
+public:
+	enum class direction {forward, backward};
+	enum class meet {unite, intersect};
+
+	/**
+	* \brief Creates an empty problem with sets over the indices [0, \p nbits).
+	*/
+	dataflow(const jlm::cfg & cfg, const direction & d, const meet & m, size_t nbits);
+
+	dataflow(const dataflow&) = delete;
+
+	dataflow &
+	operator=(const dataflow&) = delete;
+
+	bitvector &
+	gen(const cfg_node * node) noexcept;
+
+	bitvector &
+	kill(const cfg_node * node) noexcept;
+
+	bitvector &
+	boundary() noexcept
+	{
+		return boundary_;
+	}
+
+	const bitvector &
+	in(const cfg_node * node) const noexcept;
+
+	const bitvector &
+	out(const cfg_node * node) const noexcept;
+
+	/**
+	* \brief Solves the problem and returns the number of iterations.
+	*/
+	size_t
+	solve();
+
+private:
+	const jlm::cfg & cfg_;
+	direction direction_;
+	meet meet_;
+	size_t nbits_;
+	bitvector boundary_;
+	std::vector<bitvector> gen_;
+	std::vector<bitvector> kill_;
+	std::vector<bitvector> in_;
+	std::vector<bitvector> out_;
+};
+
+}
+
+#endif
@@ -94,6 +94,90 @@ private:
 	std::vector<std::unique_ptr<domnode>> children_;
 };
 
+/**
+* \brief The dominator relation of the nodes of a cfg.
+*
+* The immediate dominators are computed with the Semi-NCA algorithm over the
+* node indices of the cfg. The nodes of the dominator tree are numbered in
+* preorder, such that the nodes dominated by a node form a contiguous range
+* of numbers. Dominance queries are therefore answered in constant time.
+* Nodes that are unreachable from the entry node neither dominate nor are
+* dominated by any node. The cfg must be closed and must not be modified
+* while the dominators are in use.
+*/
+class dominators final {
+public:
+	dominators(const jlm::cfg & cfg);
+
+	dominators(const dominators&) = delete;
+
+	dominators &
+	operator=(const dominators&) = delete;
+
+	/**
+	* \brief Returns the immediate dominator of \p node.
+	*
+	* Returns null for the entry node and unreachable nodes.
+	*/
+	cfg_node *
+	idom(const cfg_node * node) const noexcept;
+
+	/**
+	* \brief Returns true if \p node is reachable from the entry node.
+	*/
+	bool
+	is_reachable(const cfg_node * node) const noexcept;
+
+	/**
+	* \brief Returns true if \p n1 dominates \p n2. Every reachable node
+	* dominates itself.
+	*/
+	bool
+	dominates(const cfg_node * n1, const cfg_node * n2) const noexcept;
+
+	bool
+	strictly_dominates(const cfg_node * n1, const cfg_node * n2) const noexcept
+	{
+		return n1 != n2 && dominates(n1, n2);
+	}
+
+	/**
+	* \brief Returns the dominance frontier of \p node ordered by node index.
+	*
+	* The frontier is computed on demand by a walk over the nodes dominated by
+	* \p node, i.e., its cost is proportional to their number.
+	*/
+	std::vector<cfg_node*>
+	frontier(const cfg_node * node) const;
+
+	/**
+	* \brief Returns the reachable nodes in preorder of the dominator tree.
+	*/
+	const std::vector<cfg_node*> &
+	preorder() const noexcept
+	{
+		return nodes_;
+	}
+
+	static std::unique_ptr<dominators>
+	create(const jlm::cfg & cfg)
+	{
+		return std::make_unique<dominators>(cfg);
+	}
+
+private:
+	static constexpr size_t unreachable = ~size_t(0);
+
+	const jlm::cfg & cfg_;
+	/* The reachable nodes in preorder of the dominator tree. */
+	std::vector<cfg_node*> nodes_;
+	/* Indexed by node index. */
+	std::vector<size_t> numbers_;
+	/* Indexed by preorder number. */
+	std::vector<size_t> idoms_;
+	std::vector<size_t> sizes_;
+};
+
 std::unique_ptr<domnode>
 domtree(jlm::cfg & cfg);
 
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_HASH_HPP
+#define JLM_IR_HASH_HPP
+
+#include <stddef.h>
+
+namespace jive {
+	class simple_op;
+	class type;
+}
+
+namespace jlm {
+
+static inline size_t
+hash_combine(size_t seed, size_t value) noexcept
+{
+	return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+/**
+* \brief Returns the hash of \p type.
+*
+* Types that are equal according to their operator== have equal hashes. The
+* hash covers the dynamic type and the parameters of the types of jive and
+* jlm, and only the dynamic type of all other types.
+*/
+size_t
+hash(const jive::type & type);
+
+/**
+* \brief Returns the hash of \p operation.
+*
+* The hash covers the dynamic type and the signature of the operation, as
+* well as the values of bit, control, and floating point constants.
+* Operations that are equal according to their operator== and have equal
+* signatures have equal hashes.
+*/
+size_t
+hash(const jive::simple_op & operation);
+
+}
+
+#endif
@@ -8,10 +8,15 @@
 
 #include <jlm/ir/basic-block.hpp>
 #include <jlm/ir/ipgraph.hpp>
+#include <jlm/ir/operation-pool.hpp>
+#include <jlm/ir/type-pool.hpp>
 #include <jlm/ir/tac.hpp>
 
+#include <jlm/util/arena.hpp>
 #include <jlm/util/file.hpp>
 
+#include <mutex>
+
 namespace jlm {
 
 /* global value */
@@ -68,7 +73,9 @@ public:
 		const jlm::filepath & source_filename,
 		const std::string & target_triple,
 		const std::string & data_layout) noexcept
-	: data_layout_(data_layout)
+	: ntacvariables_(0)
+	, nvariables_(0)
+	, data_layout_(data_layout)
 	, target_triple_(target_triple)
 	, source_filename_(source_filename)
 	{}
@@ -100,12 +107,10 @@ public:
 	inline jlm::gblvalue *
 	create_global_value(data_node * node)
 	{
-		auto v = jlm::create_gblvalue(node);
-		auto ptr = v.get();
-		globals_.insert(ptr);
-		functions_[node] = ptr;
-		variables_.insert(std::move(v));
-		return ptr;
+		auto v = variables_.create<jlm::gblvalue>(node);
+		globals_.insert(v);
+		functions_[node] = v;
+		return v;
 	}
 
 	/*
@@ -115,30 +120,47 @@ public:
 	inline jlm::tacvariable *
 	create_tacvariable(const jive::type & type)
 	{
-		static uint64_t c = 0;
-		auto v = jlm::create_tacvariable(type, strfmt("tv", c++));
-		auto pv = v.get();
-		variables_.insert(std::move(v));
-		return static_cast<tacvariable*>(pv);
+		return variables_.create<jlm::tacvariable>(types_.intern(type), "tv", ntacvariables_++);
 	}
 
 	inline jlm::variable *
 	create_variable(const jive::type & type, const std::string & name)
 	{
-		auto v = std::make_unique<jlm::variable>(type, name);
-		auto pv = v.get();
-		variables_.insert(std::move(v));
-		return pv;
+		return variables_.create<jlm::variable>(types_.intern(type), name);
 	}
 
 	inline jlm::variable *
 	create_variable(const jive::type & type)
 	{
-		static uint64_t c = 0;
-		auto v = std::make_unique<jlm::variable>(type, strfmt("v", c++));
-		auto pv = v.get();
-		variables_.insert(std::move(v));
-		return pv;
+		return create_variable(type, "v", "");
+	}
+
+	/**
+	* \brief Creates a variable named by \p prefix, a number, and \p suffix.
+	*
+	* The number is unique within the module and the name is only created on
+	* demand. The strings must outlive the module.
+	*/
+	inline jlm::variable *
+	create_variable(const jive::type & type, const char * prefix, const char * suffix)
+	{
+		return create_variable(type, prefix, nvariables_++, suffix);
+	}
+
+	/**
+	* \brief Creates a variable named by \p prefix, \p id, and \p suffix.
+	*
+	* The caller is responsible for the uniqueness of the name. The strings must
+	* outlive the module.
+	*/
+	inline jlm::variable *
+	create_variable(
+		const jive::type & type,
+		const char * prefix,
+		size_t id,
+		const char * suffix)
+	{
+		return variables_.create<jlm::variable>(types_.intern(type), prefix, id, suffix);
 	}
 
 	inline jlm::variable *
@@ -146,11 +168,55 @@ public:
 	{
 		JLM_DEBUG_ASSERT(!variable(node));
 
-		auto v = std::unique_ptr<jlm::variable>(new fctvariable(node));
-		auto pv = v.get();
-		functions_[node] = pv;
-		variables_.insert(std::move(v));
-		return pv;
+		auto v = variables_.create<fctvariable>(node);
+		functions_[node] = v;
+		return v;
+	}
+
+	/**
+	* \brief Returns the pool of the operations of the module's tacs.
+	*/
+	operation_pool &
+	operations() noexcept
+	{
+		return operations_;
+	}
+
+	const operation_pool &
+	operations() const noexcept
+	{
+		return operations_;
+	}
+
+	/**
+	* \brief Returns the pool of the types of the module's variables.
+	*/
+	const type_pool &
+	types() const noexcept
+	{
+		return types_;
+	}
+
+	/**
+	* \brief Returns the arena that owns the variables of the module.
+	*/
+	const jlm::arena &
+	arena() const noexcept
+	{
+		return variables_;
+	}
+
+	/**
+	* \brief Returns the mutex that serializes modifications of the module.
+	*
+	* Creating variables and interning types or operations is not thread-safe.
+	* Passes that process the cfgs of a module concurrently must hold the mutex
+	* while they do either.
+	*/
+	std::mutex &
+	mutex() const noexcept
+	{
+		return mutex_;
 	}
 
 	const jlm::variable *
@@ -188,13 +254,23 @@ public:
 	}
 
 private:
+	/*
+		The pools are declared first, such that they outlive the tacs and
+		variables of the module. The variables in turn outlive the tacs of
+		the ipgraph that use them.
+	*/
+	type_pool types_;
+	operation_pool operations_;
+	jlm::arena variables_;
 	jlm::ipgraph clg_;
+	size_t ntacvariables_;
+	size_t nvariables_;
 	std::string data_layout_;
 	std::string target_triple_;
 	const jlm::filepath source_filename_;
 	std::unordered_set<const jlm::gblvalue*> globals_;
-	std::unordered_set<std::unique_ptr<jlm::variable>> variables_;
 	std::unordered_map<const ipgraph_node*, const jlm::variable*> functions_;
+	mutable std::mutex mutex_;
 };
 
 static inline size_t
@@ -143,7 +143,8 @@ public:
 protected:
 	inline
 	ipgraph_node(jlm::ipgraph & clg)
-	: clg_(clg)
+	: index_(0)
+	, clg_(clg)
 	{}
 
 public:
@@ -153,6 +154,17 @@ public:
 		return clg_;
 	}
 
+	/**
+	* \brief Returns the index of the node in its ipgraph.
+	*
+	* The nodes are indexed densely in order of their insertion.
+	*/
+	size_t
+	index() const noexcept
+	{
+		return index_;
+	}
+
 	void
 	add_dependency(const ipgraph_node * dep)
 	{
@@ -190,8 +202,11 @@ public:
 	linkage() const noexcept = 0;
 
 private:
+	size_t index_;
 	jlm::ipgraph & clg_;
 	std::unordered_set<const ipgraph_node*> dependencies_;
+
+	friend jlm::ipgraph;
 };
 
 class function_node final : public ipgraph_node {
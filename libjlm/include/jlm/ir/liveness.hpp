@@ -0,0 +1,73 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_LIVENESS_HPP
+#define JLM_IR_LIVENESS_HPP
+
+#include <jlm/ir/dataflow.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace jlm {
+
+class cfg;
+class cfg_node;
+
+/**
+* \brief The live variables at the beginning and end of every node of a cfg.
+*
+* The arguments of a cfg are written by its entry node and its results are
+* read by its exit node. The operands of a phi operation are live at the end
+* of the corresponding predecessors, but not at the beginning of the node
+* containing the phi. The cfg must be closed.
+*/
+class liveness final {
+public:
+	liveness(const jlm::cfg & cfg);
+
+	liveness(const liveness&) = delete;
+
+	liveness &
+	operator=(const liveness&) = delete;
+
+	const variableindex &
+	variables() const noexcept
+	{
+		return index_;
+	}
+
+	const variableset &
+	in(const cfg_node * node) const noexcept;
+
+	const variableset &
+	out(const cfg_node * node) const noexcept;
+
+	/**
+	* \brief Returns the number of iterations until the fixed point was reached.
+	*/
+	size_t
+	niterations() const noexcept
+	{
+		return niterations_;
+	}
+
+	static std::unique_ptr<liveness>
+	create(const jlm::cfg & cfg)
+	{
+		return std::make_unique<liveness>(cfg);
+	}
+
+private:
+	const jlm::cfg & cfg_;
+	size_t niterations_;
+	variableindex index_;
+	std::vector<variableset> in_;
+	std::vector<variableset> out_;
+};
+
+}
+
+#endif
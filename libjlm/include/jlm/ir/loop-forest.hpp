@@ -0,0 +1,286 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_LOOP_FOREST_HPP
+#define JLM_IR_LOOP_FOREST_HPP
+
+#include <jlm/common.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace jlm {
+
+class cfg;
+class cfg_edge;
+class cfg_node;
+class loopforest;
+
+/**
+* \brief A loop of a cfg.
+*
+* A loop is a strongly connected component of the cfg. Its headers are the
+* nodes that are entered from outside of the loop, and its latches are the
+* nodes with an edge to a header. The nested loops are the strongly connected
+* components of the loop after the edges to its headers are removed. The
+* nodes of a loop include the nodes of all nested loops.
+*/
+class cfg_loop final {
+	typedef std::vector<cfg_node*>::const_iterator const_node_iterator;
+
+public:
+	cfg_loop(const cfg_loop&) = delete;
+
+	cfg_loop &
+	operator=(const cfg_loop&) = delete;
+
+	cfg_loop *
+	parent() const noexcept
+	{
+		return parent_;
+	}
+
+	/**
+	* \brief Returns the nesting level of the loop. Outermost loops have
+	* depth one.
+	*/
+	size_t
+	depth() const noexcept
+	{
+		return depth_;
+	}
+
+	size_t
+	nchildren() const noexcept
+	{
+		return children_.size();
+	}
+
+	cfg_loop *
+	child(size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < nchildren());
+		return children_[index];
+	}
+
+	/**
+	* \brief Returns the headers of the loop ordered by node index.
+	*/
+	size_t
+	nheaders() const noexcept
+	{
+		return headers_.size();
+	}
+
+	cfg_node *
+	header(size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < nheaders());
+		return headers_[index];
+	}
+
+	/**
+	* \brief Returns the latches of the loop ordered by node index.
+	*/
+	size_t
+	nlatches() const noexcept
+	{
+		return latches_.size();
+	}
+
+	cfg_node *
+	latch(size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < nlatches());
+		return latches_[index];
+	}
+
+	/**
+	* \brief Returns the edges that leave the loop.
+	*/
+	size_t
+	nexits() const noexcept
+	{
+		return exits_.size();
+	}
+
+	cfg_edge *
+	exit(size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < nexits());
+		return exits_[index];
+	}
+
+	size_t
+	nnodes() const noexcept
+	{
+		return end_ - begin_;
+	}
+
+	inline const_node_iterator
+	begin_nodes() const noexcept;
+
+	inline const_node_iterator
+	end_nodes() const noexcept;
+
+	inline bool
+	contains(const cfg_node * node) const noexcept;
+
+private:
+	cfg_loop(const loopforest & forest, cfg_loop * parent, size_t begin, size_t end)
+	: depth_(parent ? parent->depth()+1 : 1)
+	, begin_(begin)
+	, end_(end)
+	, parent_(parent)
+	, forest_(forest)
+	{}
+
+	size_t depth_;
+	/* The range of the nodes of the loop in the node order of the forest. */
+	size_t begin_;
+	size_t end_;
+	cfg_loop * parent_;
+	const loopforest & forest_;
+	std::vector<cfg_loop*> children_;
+	std::vector<cfg_node*> headers_;
+	std::vector<cfg_node*> latches_;
+	std::vector<cfg_edge*> exits_;
+
+	friend loopforest;
+};
+
+/**
+* \brief The loop nesting forest of a cfg.
+*
+* The loops are the strongly connected components of the nodes reachable from
+* the entry node, nested as described for cfg_loop. The forest of a reducible
+* cfg is computed in almost linear time, and the forest of an irreducible cfg
+* with cost proportional to the sum of the sizes of all loops. Nodes that are
+* added to the cfg after the construction of the forest are not part
+* of any loop. All other modifications of the cfg render the forest stale.
+*/
+class loopforest final {
+public:
+	loopforest(const jlm::cfg & cfg);
+
+	loopforest(const loopforest&) = delete;
+
+	loopforest &
+	operator=(const loopforest&) = delete;
+
+	/**
+	* \brief Returns all loops in preorder, i.e., every loop precedes its
+	* nested loops.
+	*/
+	size_t
+	nloops() const noexcept
+	{
+		return loops_.size();
+	}
+
+	cfg_loop *
+	loop(size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < nloops());
+		return loops_[index].get();
+	}
+
+	/**
+	* \brief Returns the outermost loops.
+	*/
+	size_t
+	nroots() const noexcept
+	{
+		return roots_.size();
+	}
+
+	cfg_loop *
+	root(size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < nroots());
+		return roots_[index];
+	}
+
+	/**
+	* \brief Returns the innermost loop that contains \p node, or null if the
+	* node is not part of any loop.
+	*/
+	cfg_loop *
+	innermost(const cfg_node * node) const noexcept;
+
+	/**
+	* \brief Returns the number of loops that contain \p node.
+	*/
+	size_t
+	depth(const cfg_node * node) const noexcept
+	{
+		auto loop = innermost(node);
+		return loop ? loop->depth() : 0;
+	}
+
+	const jlm::cfg &
+	cfg() const noexcept
+	{
+		return cfg_;
+	}
+
+	static std::unique_ptr<loopforest>
+	create(const jlm::cfg & cfg)
+	{
+		return std::make_unique<loopforest>(cfg);
+	}
+
+private:
+	enum : size_t { none = ~size_t(0) };
+
+	bool
+	find_natural_loops();
+
+	void
+	find_scc_loops();
+
+	void
+	layout(const std::vector<cfg_node*> & nodes);
+
+	void
+	annotate();
+
+	size_t
+	position(const cfg_node * node) const noexcept;
+
+	const jlm::cfg & cfg_;
+	std::vector<std::unique_ptr<cfg_loop>> loops_;
+	std::vector<cfg_loop*> roots_;
+	/* The nodes of all loops, such that every loop is a contiguous range. */
+	std::vector<cfg_node*> nodes_;
+	/* Indexed by node index. */
+	std::vector<size_t> positions_;
+	std::vector<cfg_loop*> innermost_;
+
+	friend cfg_loop;
+};
+
+cfg_loop::const_node_iterator
+cfg_loop::begin_nodes() const noexcept
+{
+	return forest_.nodes_.begin() + begin_;
+}
+
+cfg_loop::const_node_iterator
+cfg_loop::end_nodes() const noexcept
+{
+	return forest_.nodes_.begin() + end_;
+}
+
+bool
+cfg_loop::contains(const cfg_node * node) const noexcept
+{
+	auto position = forest_.position(node);
+	return position != loopforest::none && begin_ <= position && position < end_;
+}
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_OPERATION_POOL_HPP
+#define JLM_IR_OPERATION_POOL_HPP
+
+#include <memory>
+#include <unordered_map>
+
+namespace jive {
+	class operation;
+	class simple_op;
+}
+
+namespace jlm {
+
+/**
+* \brief A table of unique operations.
+*
+* The pool stores one instance of every distinct operation, such that tacs
+* with equal operations can share them. Operations are considered equal if
+* their operator== says so, i.e., the same criterion that common node
+* elimination uses, and are looked up by their hash(). The pool is not
+* thread-safe.
+*/
+class operation_pool final {
+public:
+	~operation_pool();
+
+	operation_pool() = default;
+
+	operation_pool(const operation_pool&) = delete;
+
+	operation_pool &
+	operator=(const operation_pool&) = delete;
+
+	/**
+	* \brief Returns the instance of the pool that equals \p operation.
+	*
+	* A copy of \p operation is added to the pool if no such instance exists.
+	*/
+	const jive::operation *
+	intern(const jive::simple_op & operation);
+
+	/**
+	* \brief Returns the number of distinct operations in the pool.
+	*/
+	size_t
+	noperations() const noexcept
+	{
+		return operations_.size();
+	}
+
+private:
+	std::unordered_multimap<size_t, std::unique_ptr<jive::operation>> operations_;
+};
+
+}
+
+#endif
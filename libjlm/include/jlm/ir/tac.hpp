@@ -8,10 +8,12 @@
 
 #include <jlm/common.hpp>
 #include <jlm/ir/variable.hpp>
+#include <jlm/util/small-vector.hpp>
 
 #include <jive/rvsdg/operation.h>
 
-#include <list>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -24,6 +26,7 @@ namespace base {
 
 namespace jlm {
 
+class operation_pool;
 class tac;
 
 /* tacvariable */
@@ -41,6 +44,15 @@ public:
 	, tac_(nullptr)
 	{}
 
+	inline
+	tacvariable(
+		const jive::type * type,
+		const char * prefix,
+		size_t id)
+	: variable (type, prefix, id)
+	, tac_(nullptr)
+	{}
+
 	inline jlm::tac *
 	tac() const noexcept
 	{
@@ -78,16 +90,39 @@ create_tacvariable(
 
 /* tac */
 
+class taclist;
+
 class tac final {
+	friend taclist;
+	friend variable;
+
 public:
-	inline
-	~tac() noexcept
-	{}
+	/*
+		Most tacs have at most three operands and one result. Their operands
+		and results are stored inline.
+	*/
+	typedef small_vector<const variable*, 3> operandvector;
+	typedef small_vector<const variable*, 1> resultvector;
+
+	~tac() noexcept;
 
 	tac(const jive::simple_op & operation,
 		const std::vector<const variable*> & operands,
 		const std::vector<const variable*> & results);
 
+	tac(const jive::simple_op & operation,
+		std::initializer_list<const variable*> operands,
+		std::initializer_list<const variable*> results);
+
+	tac(const jive::simple_op & operation,
+		operandvector operands,
+		resultvector results);
+
+	tac(operation_pool & pool,
+		const jive::simple_op & operation,
+		operandvector operands,
+		resultvector results);
+
 	tac(const jlm::tac &) = delete;
 
 	tac(jlm::tac &&) = delete;
@@ -101,9 +136,19 @@ public:
 	inline const jive::simple_op &
 	operation() const noexcept
 	{
-		return *static_cast<const jive::simple_op*>(operation_.get());
+		return *static_cast<const jive::simple_op*>(operation_);
 	}
 
+	/**
+	* \brief Replaces the operation of the tac with the equal instance in \p pool.
+	*
+	* The tac then shares its operation with all other tacs of the pool and
+	* releases its own copy. The pool must outlive the tac. Operations given to
+	* replace() later on are interned into the same pool.
+	*/
+	void
+	intern(operation_pool & pool);
+
 	inline size_t
 	noperands() const noexcept
 	{
@@ -136,6 +181,18 @@ public:
 		const std::vector<const variable*> & operands,
 		const std::vector<const variable*> & results);
 
+	void
+	replace(
+		const jive::simple_op & operation,
+		std::initializer_list<const variable*> operands,
+		std::initializer_list<const variable*> results);
+
+	void
+	replace(
+		const jive::simple_op & operation,
+		operandvector operands,
+		resultvector results);
+
 	static std::unique_ptr<jlm::tac>
 	create(
 		const jive::simple_op & operation,
@@ -145,10 +202,84 @@ public:
 		return std::make_unique<jlm::tac>(operation, operands, results);
 	}
 
+	static std::unique_ptr<jlm::tac>
+	create(
+		const jive::simple_op & operation,
+		std::initializer_list<const variable *> operands,
+		std::initializer_list<const variable *> results)
+	{
+		return std::make_unique<jlm::tac>(operation, operands, results);
+	}
+
+	static std::unique_ptr<jlm::tac>
+	create(
+		const jive::simple_op & operation,
+		operandvector operands,
+		resultvector results)
+	{
+		return std::make_unique<jlm::tac>(operation, std::move(operands), std::move(results));
+	}
+
+	/**
+	* \brief Creates a tac whose operation is interned into \p pool right away.
+	*
+	* In contrast to the other create() functions, the operation is only copied
+	* if \p pool does not contain an equal operation yet. The pool must outlive
+	* the tac.
+	*/
+	static std::unique_ptr<jlm::tac>
+	create(
+		operation_pool & pool,
+		const jive::simple_op & operation,
+		const std::vector<const variable *> & operands,
+		const std::vector<const variable *> & results)
+	{
+		return std::make_unique<jlm::tac>(pool, operation,
+			operandvector(operands.begin(), operands.end()),
+			resultvector(results.begin(), results.end()));
+	}
+
+	static std::unique_ptr<jlm::tac>
+	create(
+		operation_pool & pool,
+		const jive::simple_op & operation,
+		std::initializer_list<const variable *> operands,
+		std::initializer_list<const variable *> results)
+	{
+		return std::make_unique<jlm::tac>(pool, operation, operandvector(operands),
+			resultvector(results));
+	}
+
 private:
-	std::vector<const variable*> results_;
-	std::vector<const variable*> operands_;
-	std::unique_ptr<jive::operation> operation_;
+	/*
+		Registers and unregisters the tac as user of its operands.
+	*/
+	void
+	add_users();
+
+	void
+	remove_users() noexcept;
+
+	/*
+		The links of the taclist the tac is part of.
+	*/
+	jlm::tac * prev_;
+	jlm::tac * next_;
+
+	resultvector results_;
+	operandvector operands_;
+	/*
+		The entries of the tac in the use lists of its distinct operands. They
+		are linked into the lists, and must therefore not be reallocated while
+		the tac uses its operands. Most tacs have at most two distinct operands.
+	*/
+	small_vector<variable_use, 2> uses_;
+	/*
+		The operation is owned by the tac as long as it is not interned, i.e.,
+		as long as pool_ is null.
+	*/
+	const jive::operation * operation_;
+	operation_pool * pool_;
 };
 
 template <class T> static inline bool
@@ -164,22 +295,106 @@ typedef std::vector<std::unique_ptr<jlm::tac>> tacsvector_t;
 
 /* taclist */
 
+/**
+* \brief An intrusive doubly linked list of tacs.
+*
+* The links are embedded in the tacs, such that inserting and removing tacs
+* does not allocate. The list owns its tacs.
+*/
 class taclist final {
 public:
-	typedef std::list<tac*>::const_iterator const_iterator;
-	typedef std::list<tac*>::const_reverse_iterator const_reverse_iterator;
+	class const_iterator final {
+		friend taclist;
+
+	public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef jlm::tac * value_type;
+		typedef ptrdiff_t difference_type;
+		typedef jlm::tac ** pointer;
+		typedef jlm::tac * reference;
+
+		constexpr
+		const_iterator(const taclist * list, jlm::tac * tac) noexcept
+		: tac_(tac)
+		, list_(list)
+		{}
+
+		jlm::tac *
+		operator*() const noexcept
+		{
+			JLM_DEBUG_ASSERT(tac_ != nullptr);
+			return tac_;
+		}
+
+		const_iterator &
+		operator++() noexcept
+		{
+			JLM_DEBUG_ASSERT(tac_ != nullptr);
+			tac_ = tac_->next_;
+			return *this;
+		}
+
+		const_iterator
+		operator++(int) noexcept
+		{
+			const_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		const_iterator &
+		operator--() noexcept
+		{
+			tac_ = tac_ ? tac_->prev_ : list_->last_;
+			JLM_DEBUG_ASSERT(tac_ != nullptr);
+			return *this;
+		}
+
+		const_iterator
+		operator--(int) noexcept
+		{
+			const_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		bool
+		operator==(const const_iterator & other) const noexcept
+		{
+			return tac_ == other.tac_ && list_ == other.list_;
+		}
+
+		bool
+		operator!=(const const_iterator & other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+	private:
+		jlm::tac * tac_;
+		const taclist * list_;
+	};
+
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
 	~taclist();
 
 	inline
 	taclist()
+	: ntacs_(0)
+	, first_(nullptr)
+	, last_(nullptr)
 	{}
 
 	taclist(const taclist&) = delete;
 
 	taclist(taclist && other)
-	: tacs_(std::move(other.tacs_))
-	{}
+	: ntacs_(other.ntacs_)
+	, first_(other.first_)
+	, last_(other.last_)
+	{
+		other.reset();
+	}
 
 	taclist &
 	operator=(const taclist &) = delete;
@@ -190,11 +405,11 @@ public:
 		if (this == &other)
 			return *this;
 
-		for (const auto & tac : tacs_)
-			delete tac;
-
-		tacs_.clear();
-		tacs_ = std::move(other.tacs_);
+		clear();
+		ntacs_ = other.ntacs_;
+		first_ = other.first_;
+		last_ = other.last_;
+		other.reset();
 
 		return *this;
 	}
@@ -202,108 +417,162 @@ public:
 	inline const_iterator
 	begin() const noexcept
 	{
-		return tacs_.begin();
+		return const_iterator(this, first_);
 	}
 
 	inline const_reverse_iterator
 	rbegin() const noexcept
 	{
-		return tacs_.rbegin();
+		return const_reverse_iterator(end());
 	}
 
 	inline const_iterator
 	end() const noexcept
 	{
-		return tacs_.end();
+		return const_iterator(this, nullptr);
 	}
 
 	inline const_reverse_iterator
 	rend() const noexcept
 	{
-		return tacs_.rend();
+		return const_reverse_iterator(begin());
 	}
 
 	inline tac *
 	insert_before(const const_iterator & it, std::unique_ptr<jlm::tac> tac)
 	{
-		return *tacs_.insert(it, tac.release());
+		JLM_DEBUG_ASSERT(it.list_ == this);
+
+		auto t = tac.release();
+		link(it.tac_, t, t);
+		ntacs_++;
+		return t;
 	}
 
+	/**
+	* \brief Moves all tacs of \p tl before \p it.
+	*/
 	inline void
 	insert_before(const const_iterator & it, taclist & tl)
 	{
-		tacs_.insert(it, tl.begin(), tl.end());
+		JLM_DEBUG_ASSERT(it.list_ == this && &tl != this);
+		if (tl.ntacs_ == 0)
+			return;
+
+		link(it.tac_, tl.first_, tl.last_);
+		ntacs_ += tl.ntacs_;
+		tl.reset();
 	}
 
 	inline void
 	append_last(std::unique_ptr<jlm::tac> tac)
 	{
-		tacs_.push_back(tac.release());
+		insert_before(end(), std::move(tac));
 	}
 
 	inline void
 	append_first(std::unique_ptr<jlm::tac> tac)
 	{
-		tacs_.push_front(tac.release());
+		insert_before(begin(), std::move(tac));
 	}
 
 	inline void
 	append_first(taclist & tl)
 	{
-		tacs_.insert(tacs_.begin(), tl.begin(), tl.end());
-		tl.tacs_.clear();
+		insert_before(begin(), tl);
 	}
 
 	inline size_t
 	ntacs() const noexcept
 	{
-		return tacs_.size();
+		return ntacs_;
 	}
 
 	inline tac *
 	first() const noexcept
 	{
-		return ntacs() != 0 ? tacs_.front() : nullptr;
+		return first_;
 	}
 
 	inline tac *
 	last() const noexcept
 	{
-		return ntacs() != 0 ? tacs_.back() : nullptr;
+		return last_;
 	}
 
 	std::unique_ptr<tac>
 	pop_first() noexcept
 	{
-		std::unique_ptr<tac> tac(tacs_.front());
-		tacs_.pop_front();
-		return tac;
+		return std::unique_ptr<tac>(unlink(first_));
 	}
 
 	std::unique_ptr<tac>
 	pop_last() noexcept
 	{
-		std::unique_ptr<tac> tac(tacs_.back());
-		tacs_.pop_back();
-		return tac;
+		return std::unique_ptr<tac>(unlink(last_));
 	}
 
 	inline void
 	drop_first()
 	{
-		delete tacs_.front();
-		tacs_.pop_front();
+		delete unlink(first_);
 	}
 
 	inline void
 	drop_last()
 	{
-		delete tacs_.back();
-		tacs_.pop_back();
+		delete unlink(last_);
 	}
 
 private:
-	std::list<tac*> tacs_;
+	/*
+		Links the chain of tacs from \p first to \p last before \p successor.
+		The chain is appended if \p successor is null.
+	*/
+	void
+	link(jlm::tac * successor, jlm::tac * first, jlm::tac * last) noexcept
+	{
+		auto predecessor = successor ? successor->prev_ : last_;
+
+		first->prev_ = predecessor;
+		last->next_ = successor;
+
+		if (predecessor) predecessor->next_ = first;
+		else first_ = first;
+
+		if (successor) successor->prev_ = last;
+		else last_ = last;
+	}
+
+	jlm::tac *
+	unlink(jlm::tac * tac) noexcept
+	{
+		JLM_DEBUG_ASSERT(tac != nullptr && ntacs_ != 0);
+
+		if (tac->prev_) tac->prev_->next_ = tac->next_;
+		else first_ = tac->next_;
+
+		if (tac->next_) tac->next_->prev_ = tac->prev_;
+		else last_ = tac->prev_;
+
+		tac->prev_ = tac->next_ = nullptr;
+		ntacs_--;
+		return tac;
+	}
+
+	void
+	reset() noexcept
+	{
+		ntacs_ = 0;
+		first_ = last_ = nullptr;
+	}
+
+	void
+	clear() noexcept;
+
+	size_t ntacs_;
+	jlm::tac * first_;
+	jlm::tac * last_;
 };
 
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_TYPE_POOL_HPP
+#define JLM_IR_TYPE_POOL_HPP
+
+#include <memory>
+#include <unordered_map>
+
+namespace jive {
+	class type;
+}
+
+namespace jlm {
+
+/**
+* \brief A table of unique types.
+*
+* The pool stores one instance of every distinct type, such that variables
+* with equal types can share them. Types are considered equal if their
+* operator== says so, and are looked up by their hash(). The pool is not
+* thread-safe.
+*/
+class type_pool final {
+public:
+	~type_pool();
+
+	type_pool() = default;
+
+	type_pool(const type_pool&) = delete;
+
+	type_pool &
+	operator=(const type_pool&) = delete;
+
+	/**
+	* \brief Returns the instance of the pool that equals \p type.
+	*
+	* A copy of \p type is added to the pool if no such instance exists.
+	*/
+	const jive::type *
+	intern(const jive::type & type);
+
+	/**
+	* \brief Returns the number of distinct types in the pool.
+	*/
+	size_t
+	ntypes() const noexcept
+	{
+		return types_.size();
+	}
+
+private:
+	std::unordered_multimap<size_t, std::unique_ptr<jive::type>> types_;
+};
+
+}
+
+#endif
@@ -8,14 +8,158 @@
 
 #include <jive/rvsdg/type.h>
 
+#include <jlm/common.hpp>
 #include <jlm/ir/linkage.hpp>
 #include <jlm/util/strfmt.hpp>
 
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
 
 namespace jlm {
 
+class tac;
+class variable;
+
+/* use list */
+
+/*
+	An entry of the use list of a variable. A tac owns one entry for each of
+	its distinct operands, in the order of their first occurrence.
+*/
+struct variable_use {
+	jlm::tac * tac;
+	variable_use * prev;
+	variable_use * next;
+};
+
+/**
+* \brief An intrusive doubly linked list of the tacs that use a variable.
+*
+* The tacs are listed in the order in which they started to use the variable.
+* Appending and removing tacs does not allocate.
+*/
+class use_list final {
+public:
+	class const_iterator final {
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef jlm::tac * value_type;
+		typedef ptrdiff_t difference_type;
+		typedef jlm::tac ** pointer;
+		typedef jlm::tac * reference;
+
+		constexpr
+		const_iterator(const variable_use * use) noexcept
+		: use_(use)
+		{}
+
+		jlm::tac *
+		operator*() const noexcept
+		{
+			JLM_DEBUG_ASSERT(use_ != nullptr);
+			return use_->tac;
+		}
+
+		const_iterator &
+		operator++() noexcept
+		{
+			JLM_DEBUG_ASSERT(use_ != nullptr);
+			use_ = use_->next;
+			return *this;
+		}
+
+		const_iterator
+		operator++(int) noexcept
+		{
+			const_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool
+		operator==(const const_iterator & other) const noexcept
+		{
+			return use_ == other.use_;
+		}
+
+		bool
+		operator!=(const const_iterator & other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+	private:
+		const variable_use * use_;
+	};
+
+	use_list() noexcept
+	: size_(0)
+	, first_(nullptr)
+	, last_(nullptr)
+	{}
+
+	use_list(const use_list&) = delete;
+
+	use_list &
+	operator=(const use_list&) = delete;
+
+	size_t
+	size() const noexcept
+	{
+		return size_;
+	}
+
+	const_iterator
+	begin() const noexcept
+	{
+		return const_iterator(first_);
+	}
+
+	const_iterator
+	end() const noexcept
+	{
+		return const_iterator(nullptr);
+	}
+
+	void
+	append(variable_use * use) noexcept
+	{
+		use->prev = last_;
+		use->next = nullptr;
+		if (last_ != nullptr)
+			last_->next = use;
+		else
+			first_ = use;
+		last_ = use;
+		size_++;
+	}
+
+	void
+	remove(variable_use * use) noexcept
+	{
+		JLM_DEBUG_ASSERT(size_ > 0);
+		if (use->prev != nullptr)
+			use->prev->next = use->next;
+		else
+			first_ = use->next;
+
+		if (use->next != nullptr)
+			use->next->prev = use->prev;
+		else
+			last_ = use->prev;
+
+		use->prev = use->next = nullptr;
+		size_--;
+	}
+
+private:
+	size_t size_;
+	variable_use * first_;
+	variable_use * last_;
+};
+
 /* variable */
 
 class variable {
@@ -25,24 +169,63 @@ public:
 
 	inline
 	variable(const jive::type & type, const std::string & name)
-	: name_(name)
-	, type_(type.copy())
+	: id_(0)
+	, prefix_(nullptr)
+	, suffix_(nullptr)
+	, name_(name)
+	, type_(nullptr)
+	, copy_(type.copy())
+	{
+		type_ = copy_.get();
+	}
+
+	/**
+	* \brief Creates a variable that shares the type \p type.
+	*
+	* The variable does not copy the type. It must outlive the variable, e.g.,
+	* as part of the type pool of a module.
+	*/
+	inline
+	variable(const jive::type * type, const std::string & name)
+	: id_(0)
+	, prefix_(nullptr)
+	, suffix_(nullptr)
+	, name_(name)
+	, type_(type)
 	{}
 
-	variable(variable && other)
-	: name_(std::move(other.name_))
-	, type_(std::move(other.type_))
+	/**
+	* \brief Creates a variable with a numbered name.
+	*
+	* The name of the variable is the concatenation of \p prefix, \p id, and
+	* \p suffix. It is only created once it is requested, e.g., for printing.
+	* The strings must outlive the variable, i.e., they are usually literals.
+	*/
+	inline
+	variable(
+		const jive::type * type,
+		const char * prefix,
+		size_t id,
+		const char * suffix = "")
+	: id_(id)
+	, prefix_(prefix)
+	, suffix_(suffix)
+	, type_(type)
 	{}
 
+	/*
+		The tacs that use a variable refer to it by address. It can therefore
+		neither be copied nor moved.
+	*/
+	variable(const variable &) = delete;
+
+	variable(variable &&) = delete;
+
 	variable &
-	operator=(variable && other)
-	{
-		if (this == &other)
-			return *this;
+	operator=(const variable &) = delete;
 
-		name_ = std::move(other.name_);
-		type_ = std::move(other.type_);
-	}
+	variable &
+	operator=(variable &&) = delete;
 
 	virtual std::string
 	debug_string() const;
@@ -50,6 +233,13 @@ public:
 	inline const std::string &
 	name() const noexcept
 	{
+		if (prefix_ != nullptr) {
+			std::call_once(named_, [this]()
+			{
+				name_ = std::string(prefix_) + std::to_string(id_) + suffix_;
+			});
+		}
+
 		return name_;
 	}
 
@@ -59,9 +249,47 @@ public:
 		return *type_;
 	}
 
+	/**
+	* \brief Returns the tacs that use the variable as operand.
+	*
+	* A tac uses its operands from its creation until its destruction,
+	* independent of whether it is part of a basic block. Every tac is listed
+	* once, in the order in which the tacs started to use the variable. The
+	* users must be destructed before the variable.
+	*/
+	inline const use_list &
+	users() const noexcept
+	{
+		return users_;
+	}
+
+	inline size_t
+	nusers() const noexcept
+	{
+		return users_.size();
+	}
+
 private:
-	std::string name_;
-	std::unique_ptr<jive::type> type_;
+	size_t id_;
+	const char * prefix_;
+	const char * suffix_;
+	/*
+		Numbered names are materialized on first use by name(). The once flag
+		makes this safe for variables that are printed concurrently.
+	*/
+	mutable std::string name_;
+	mutable std::once_flag named_;
+	const jive::type * type_;
+	std::unique_ptr<jive::type> copy_;
+
+	/*
+		FIXME: The users are updated whenever a tac is created, replaced, or
+		destroyed. Tacs that use the same variable must therefore not be
+		created or destroyed concurrently.
+	*/
+	mutable use_list users_;
+
+	friend jlm::tac;
 };
 
 template <class T> static inline bool
@@ -21,6 +21,17 @@ class stats_descriptor;
 std::unique_ptr<rvsdg_module>
 construct_rvsdg(const ipgraph_module & im, const stats_descriptor & sd);
 
+/**
+* \brief Constructs the RVSDG of \p im with up to \p nthreads threads.
+*
+* The cfgs of all functions are restructured, aggregated, and annotated on
+* \p nthreads worker threads before the calling thread builds the RVSDG from
+* them. The RVSDG does not depend on the number of threads. With \p nthreads
+* smaller than two, this is equivalent to the serial construct_rvsdg().
+*/
+std::unique_ptr<rvsdg_module>
+construct_rvsdg(const ipgraph_module & im, const stats_descriptor & sd, size_t nthreads);
+
 }
 
 #endif
@@ -19,6 +19,12 @@ restructure_loops(jlm::cfg * cfg);
 void
 restructure_branches(jlm::cfg * cfg);
 
+/**
+* \brief Restructures \p cfg such that it becomes proper structured.
+*
+* The cfgs of a module can be restructured concurrently, as long as no other
+* thread modifies the module in the meantime.
+*/
 void
 restructure(jlm::cfg * cfg);
 
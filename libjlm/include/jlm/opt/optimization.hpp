@@ -6,6 +6,10 @@
 #ifndef JLM_OPT_OPTIMIZATION_HPP
 #define JLM_OPT_OPTIMIZATION_HPP
 
+#include <stddef.h>
+
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace jlm {
@@ -25,6 +29,153 @@ optimize(rvsdg_module & rm,
 	const stats_descriptor & sd,
 	const std::vector<optimization> & opts);
 
+std::string
+to_str(const optimization & opt);
+
+/**
+* \brief A pipeline of optimizations.
+*
+* Pipelines are composed of plain optimization sequences, groups of
+* pipelines, and repeat blocks that iterate their body until a fixed point is
+* reached. They are created with parse_pipeline() from strings such as
+* "iln,repeat[8](red,cne,dne),psh".
+*/
+class pipeline {
+public:
+	virtual
+	~pipeline();
+
+	virtual std::string
+	to_str() const = 0;
+
+	virtual void
+	run(rvsdg_module & rm, const stats_descriptor & sd) const = 0;
+};
+
+class optimization_pipeline final : public pipeline {
+public:
+	virtual
+	~optimization_pipeline();
+
+	optimization_pipeline(const std::vector<optimization> & opts)
+	: opts_(opts)
+	{}
+
+	const std::vector<optimization> &
+	optimizations() const noexcept
+	{
+		return opts_;
+	}
+
+	virtual std::string
+	to_str() const override;
+
+	virtual void
+	run(rvsdg_module & rm, const stats_descriptor & sd) const override;
+
+	static std::unique_ptr<pipeline>
+	create(const std::vector<optimization> & opts)
+	{
+		return std::unique_ptr<pipeline>(new optimization_pipeline(opts));
+	}
+
+private:
+	std::vector<optimization> opts_;
+};
+
+class sequence_pipeline final : public pipeline {
+public:
+	virtual
+	~sequence_pipeline();
+
+	sequence_pipeline(std::vector<std::unique_ptr<pipeline>> pipelines)
+	: pipelines_(std::move(pipelines))
+	{}
+
+	virtual std::string
+	to_str() const override;
+
+	virtual void
+	run(rvsdg_module & rm, const stats_descriptor & sd) const override;
+
+	static std::unique_ptr<pipeline>
+	create(std::vector<std::unique_ptr<pipeline>> pipelines)
+	{
+		return std::unique_ptr<pipeline>(new sequence_pipeline(std::move(pipelines)));
+	}
+
+private:
+	std::vector<std::unique_ptr<pipeline>> pipelines_;
+};
+
+/**
+* \brief Repeats its body until the graph reaches a fixed point.
+*
+* The body is performed until a round leaves the number of nodes and inputs
+* of the graph unchanged, or until \p maxiterations rounds were performed.
+*/
+class repeat_pipeline final : public pipeline {
+public:
+	static const size_t default_maxiterations = 10;
+
+	virtual
+	~repeat_pipeline();
+
+	repeat_pipeline(std::unique_ptr<pipeline> body, size_t maxiterations)
+	: maxiterations_(maxiterations)
+	, body_(std::move(body))
+	{}
+
+	size_t
+	maxiterations() const noexcept
+	{
+		return maxiterations_;
+	}
+
+	virtual std::string
+	to_str() const override;
+
+	virtual void
+	run(rvsdg_module & rm, const stats_descriptor & sd) const override;
+
+	static std::unique_ptr<pipeline>
+	create(std::unique_ptr<pipeline> body, size_t maxiterations = default_maxiterations)
+	{
+		return std::unique_ptr<pipeline>(new repeat_pipeline(std::move(body), maxiterations));
+	}
+
+private:
+	size_t maxiterations_;
+	std::unique_ptr<pipeline> body_;
+};
+
+/**
+* \brief Parses a pipeline description.
+*
+* The grammar is:
+*
+* pipeline := element (',' element)*
+* element := optimization | '(' pipeline ')' | 'repeat' ['[' number ']'] '(' pipeline ')'
+*
+* Throws jlm::error for malformed descriptions.
+*/
+std::unique_ptr<pipeline>
+parse_pipeline(const std::string & str);
+
+/**
+* \brief Returns the pipeline of optimization level \p level.
+*
+* Level 0 performs no optimizations, and levels larger than 3 are
+* equivalent to level 3.
+*/
+std::unique_ptr<pipeline>
+create_pipeline(size_t level);
+
+void
+optimize(rvsdg_module & rm,
+	const stats_descriptor & sd,
+	const pipeline & pl);
+
 }
 
 #endif
@@ -8,7 +8,7 @@
 
 namespace jlm {
 
-class rvsdg;
+class rvsdg_module;
 class stats_descriptor;
 
 void
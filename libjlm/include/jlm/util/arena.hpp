@@ -0,0 +1,140 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_UTIL_ARENA_HPP
+#define JLM_UTIL_ARENA_HPP
+
+#include <jlm/common.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jlm {
+
+/**
+* \brief A region based allocator.
+*
+* Objects are carved out of large blocks and are never freed individually.
+* All objects are destructed in reverse order of creation and their blocks
+* are released at once when the arena is destructed. An arena is not
+* thread-safe.
+*/
+class arena final {
+	typedef void (*destructor)(void*);
+
+public:
+	~arena()
+	{
+		for (auto it = objects_.rbegin(); it != objects_.rend(); it++)
+			it->first(it->second);
+	}
+
+	arena(size_t blocksize = 64*1024)
+	: nbytes_(0)
+	, nobjects_(0)
+	, blocksize_(blocksize)
+	, current_(nullptr)
+	, end_(nullptr)
+	{}
+
+	arena(const arena&) = delete;
+
+	arena &
+	operator=(const arena&) = delete;
+
+	/**
+	* \brief Returns \p size bytes of uninitialized memory aligned to \p alignment.
+	*/
+	void *
+	allocate(size_t size, size_t alignment)
+	{
+		JLM_DEBUG_ASSERT(alignment != 0 && (alignment & (alignment-1)) == 0);
+
+		auto p = align(current_, alignment);
+		if (current_ == nullptr || p + size > end_) {
+			if (size + alignment > blocksize_) {
+				blocks_.push_back(std::unique_ptr<char[]>(new char[size + alignment]));
+				nbytes_ += size + alignment;
+				return align(blocks_.back().get(), alignment);
+			}
+
+			blocks_.push_back(std::unique_ptr<char[]>(new char[blocksize_]));
+			current_ = blocks_.back().get();
+			end_ = current_ + blocksize_;
+			nbytes_ += blocksize_;
+			p = align(current_, alignment);
+		}
+
+		current_ = p + size;
+		return p;
+	}
+
+	/**
+	* \brief Constructs an object of type \p T in the arena.
+	*
+	* The object is destructed together with the arena.
+	*/
+	template <class T, class... Args> T *
+	create(Args&&... args)
+	{
+		auto object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		if (!std::is_trivially_destructible<T>::value)
+			objects_.push_back({[](void * p){ static_cast<T*>(p)->~T(); }, object});
+
+		nobjects_++;
+		return object;
+	}
+
+	/**
+	* \brief Returns the number of objects created in the arena.
+	*/
+	size_t
+	nobjects() const noexcept
+	{
+		return nobjects_;
+	}
+
+	/**
+	* \brief Returns the number of blocks allocated by the arena.
+	*/
+	size_t
+	nblocks() const noexcept
+	{
+		return blocks_.size();
+	}
+
+	/**
+	* \brief Returns the number of bytes allocated by the arena.
+	*/
+	size_t
+	nbytes() const noexcept
+	{
+		return nbytes_;
+	}
+
+private:
+	static char *
+	align(char * p, size_t alignment) noexcept
+	{
+		auto address = reinterpret_cast<uintptr_t>(p);
+		return p + ((alignment - address % alignment) % alignment);
+	}
+
+	size_t nbytes_;
+	size_t nobjects_;
+	size_t blocksize_;
+	char * current_;
+	char * end_;
+	std::vector<std::unique_ptr<char[]>> blocks_;
+	std::vector<std::pair<destructor, void*>> objects_;
+};
+
+}
+
+#endif
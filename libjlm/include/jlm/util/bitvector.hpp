@@ -0,0 +1,391 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_UTIL_BITVECTOR_HPP
+#define JLM_UTIL_BITVECTOR_HPP
+
+#include <jlm/common.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace jlm {
+
+/**
+* \brief A set of small non-negative integers.
+*
+* Sets with few elements relative to their largest element are stored as
+* sorted vector of their elements. All other sets are stored as vector of
+* 64-bit words, such that the set operations reduce to loops over words. A
+* sparse set is converted to a dense one once the dense representation
+* becomes smaller. Dense sets are never converted back.
+*/
+class bitvector final {
+	typedef uint64_t word;
+
+	static constexpr size_t wordbits = 64;
+
+public:
+	class const_iterator final {
+		friend bitvector;
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef size_t value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const size_t * pointer;
+		typedef size_t reference;
+
+		size_t
+		operator*() const noexcept
+		{
+			return bv_->dense_ ? position_ : bv_->elements_[position_];
+		}
+
+		const_iterator &
+		operator++() noexcept
+		{
+			position_ = bv_->dense_ ? bv_->next(position_+1) : position_+1;
+			return *this;
+		}
+
+		const_iterator
+		operator++(int) noexcept
+		{
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool
+		operator==(const const_iterator & other) const noexcept
+		{
+			return bv_ == other.bv_ && position_ == other.position_;
+		}
+
+		bool
+		operator!=(const const_iterator & other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+	private:
+		const_iterator(const bitvector * bv, size_t position) noexcept
+		: bv_(bv)
+		, position_(position)
+		{}
+
+		const bitvector * bv_;
+		/*
+			The element itself for dense sets, and the position of the element
+			in the element vector for sparse sets.
+		*/
+		size_t position_;
+	};
+
+	bitvector() noexcept
+	: dense_(false)
+	{}
+
+	bitvector(std::initializer_list<size_t> elements)
+	: bitvector()
+	{
+		for (const auto & element : elements)
+			insert(element);
+	}
+
+	const_iterator
+	begin() const noexcept
+	{
+		return const_iterator(this, dense_ ? next(0) : 0);
+	}
+
+	const_iterator
+	end() const noexcept
+	{
+		return const_iterator(this, dense_ ? words_.size()*wordbits : elements_.size());
+	}
+
+	/**
+	* \brief Returns true if the set is stored as vector of words.
+	*/
+	bool
+	is_dense() const noexcept
+	{
+		return dense_;
+	}
+
+	size_t
+	size() const noexcept
+	{
+		if (!dense_)
+			return elements_.size();
+
+		size_t n = 0;
+		for (const auto & w : words_)
+			n += __builtin_popcountll(w);
+
+		return n;
+	}
+
+	bool
+	empty() const noexcept
+	{
+		if (!dense_)
+			return elements_.empty();
+
+		return std::all_of(words_.begin(), words_.end(), [](word w){ return w == 0; });
+	}
+
+	bool
+	contains(size_t element) const noexcept
+	{
+		if (dense_) {
+			auto index = element / wordbits;
+			return index < words_.size() && (words_[index] & mask(element)) != 0;
+		}
+
+		return std::binary_search(elements_.begin(), elements_.end(), element);
+	}
+
+	void
+	insert(size_t element)
+	{
+		if (dense_) {
+			grow(element+1);
+			words_[element / wordbits] |= mask(element);
+			return;
+		}
+
+		auto it = std::lower_bound(elements_.begin(), elements_.end(), element);
+		if (it != elements_.end() && *it == element)
+			return;
+
+		elements_.insert(it, element);
+		densify_if_smaller();
+	}
+
+	void
+	erase(size_t element) noexcept
+	{
+		if (dense_) {
+			auto index = element / wordbits;
+			if (index < words_.size())
+				words_[index] &= ~mask(element);
+			return;
+		}
+
+		auto it = std::lower_bound(elements_.begin(), elements_.end(), element);
+		if (it != elements_.end() && *it == element)
+			elements_.erase(it);
+	}
+
+	void
+	clear() noexcept
+	{
+		dense_ = false;
+		words_.clear();
+		elements_.clear();
+	}
+
+	/**
+	* \brief Adds all elements of \p other to the set.
+	*/
+	bitvector &
+	operator|=(const bitvector & other)
+	{
+		if (!dense_ && !other.dense_) {
+			std::vector<size_t> elements;
+			elements.reserve(elements_.size() + other.elements_.size());
+			std::set_union(elements_.begin(), elements_.end(),
+				other.elements_.begin(), other.elements_.end(), std::back_inserter(elements));
+			elements_ = std::move(elements);
+			densify_if_smaller();
+			return *this;
+		}
+
+		densify();
+		if (!other.dense_) {
+			for (const auto & element : other.elements_)
+				insert(element);
+			return *this;
+		}
+
+		grow(other.words_.size()*wordbits);
+		for (size_t n = 0; n < other.words_.size(); n++)
+			words_[n] |= other.words_[n];
+
+		return *this;
+	}
+
+	/**
+	* \brief Removes all elements from the set that are not in \p other.
+	*/
+	bitvector &
+	operator&=(const bitvector & other)
+	{
+		if (!dense_) {
+			auto it = std::remove_if(elements_.begin(), elements_.end(),
+				[&](size_t element){ return !other.contains(element); });
+			elements_.erase(it, elements_.end());
+			return *this;
+		}
+
+		if (!other.dense_) {
+			std::vector<size_t> elements;
+			for (const auto & element : other.elements_) {
+				if (contains(element))
+					elements.push_back(element);
+			}
+			*this = bitvector(std::move(elements));
+			return *this;
+		}
+
+		words_.resize(std::min(words_.size(), other.words_.size()));
+		for (size_t n = 0; n < words_.size(); n++)
+			words_[n] &= other.words_[n];
+
+		return *this;
+	}
+
+	/**
+	* \brief Removes all elements of \p other from the set.
+	*/
+	bitvector &
+	operator-=(const bitvector & other)
+	{
+		if (!dense_) {
+			auto it = std::remove_if(elements_.begin(), elements_.end(),
+				[&](size_t element){ return other.contains(element); });
+			elements_.erase(it, elements_.end());
+			return *this;
+		}
+
+		if (!other.dense_) {
+			for (const auto & element : other.elements_)
+				erase(element);
+			return *this;
+		}
+
+		auto nwords = std::min(words_.size(), other.words_.size());
+		for (size_t n = 0; n < nwords; n++)
+			words_[n] &= ~other.words_[n];
+
+		return *this;
+	}
+
+	bool
+	operator==(const bitvector & other) const noexcept
+	{
+		if (!dense_ && !other.dense_)
+			return elements_ == other.elements_;
+
+		if (dense_ && other.dense_) {
+			auto & small = words_.size() < other.words_.size() ? words_ : other.words_;
+			auto & large = words_.size() < other.words_.size() ? other.words_ : words_;
+			return std::equal(small.begin(), small.end(), large.begin())
+			    && std::all_of(large.begin() + small.size(), large.end(),
+			         [](word w){ return w == 0; });
+		}
+
+		auto & sparse = dense_ ? other : *this;
+		auto & dense = dense_ ? *this : other;
+		if (sparse.size() != dense.size())
+			return false;
+
+		return std::all_of(sparse.elements_.begin(), sparse.elements_.end(),
+			[&](size_t element){ return dense.contains(element); });
+	}
+
+	bool
+	operator!=(const bitvector & other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+private:
+	explicit
+	bitvector(std::vector<size_t> elements) noexcept
+	: dense_(false)
+	, elements_(std::move(elements))
+	{}
+
+	static word
+	mask(size_t element) noexcept
+	{
+		return word(1) << (element % wordbits);
+	}
+
+	/*
+		Returns the smallest element of a dense set that is larger or equal to
+		\p element, or the number of bits of the set if there is none.
+	*/
+	size_t
+	next(size_t element) const noexcept
+	{
+		JLM_DEBUG_ASSERT(dense_);
+
+		auto index = element / wordbits;
+		if (index >= words_.size())
+			return words_.size()*wordbits;
+
+		auto w = words_[index] & (~word(0) << (element % wordbits));
+		while (w == 0) {
+			if (++index == words_.size())
+				return words_.size()*wordbits;
+			w = words_[index];
+		}
+
+		return index*wordbits + __builtin_ctzll(w);
+	}
+
+	void
+	grow(size_t nbits)
+	{
+		auto nwords = (nbits + wordbits - 1) / wordbits;
+		if (nwords > words_.size())
+			words_.resize(nwords, 0);
+	}
+
+	void
+	densify()
+	{
+		if (dense_)
+			return;
+
+		dense_ = true;
+		if (!elements_.empty())
+			grow(elements_.back()+1);
+		for (const auto & element : elements_)
+			words_[element / wordbits] |= mask(element);
+
+		elements_.clear();
+		elements_.shrink_to_fit();
+	}
+
+	void
+	densify_if_smaller()
+	{
+		JLM_DEBUG_ASSERT(!dense_);
+
+		if (elements_.empty())
+			return;
+
+		auto nwords = elements_.back() / wordbits + 1;
+		if (elements_.size() > nwords)
+			densify();
+	}
+
+	bool dense_;
+	std::vector<word> words_;
+	std::vector<size_t> elements_;
+};
+
+}
+
+#endif
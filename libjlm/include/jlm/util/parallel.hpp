@@ -0,0 +1,73 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_UTIL_PARALLEL_HPP
+#define JLM_UTIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jlm {
+
+/**
+* \brief Invokes \p f for every index in [0, \p n) on up to \p nthreads threads.
+*
+* Indices are handed out in increasing order to the first idle thread. The
+* calling thread participates in the work and the function returns once all
+* indices are processed. If an invocation of \p f throws, no further indices
+* are handed out and the first exception is rethrown in the calling thread.
+*/
+static inline void
+parallel_for(size_t n, size_t nthreads, const std::function<void(size_t)> & f)
+{
+	if (nthreads < 2 || n < 2) {
+		for (size_t i = 0; i < n; i++)
+			f(i);
+		return;
+	}
+
+	std::mutex mutex;
+	std::exception_ptr exception;
+	std::atomic<size_t> next(0);
+	std::atomic<bool> failed(false);
+
+	auto worker = [&]()
+	{
+		while (!failed) {
+			auto i = next++;
+			if (i >= n)
+				break;
+
+			try {
+				f(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> guard(mutex);
+				if (!exception)
+					exception = std::current_exception();
+				failed = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < std::min(nthreads, n); t++)
+		threads.push_back(std::thread(worker));
+
+	worker();
+	for (auto & thread : threads)
+		thread.join();
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+}
+
+#endif
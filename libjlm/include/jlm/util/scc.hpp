@@ -0,0 +1,161 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_UTIL_SCC_HPP
+#define JLM_UTIL_SCC_HPP
+
+#include <jlm/common.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace jlm {
+
+/**
+* \brief Finds strongly connected components with Tarjan's algorithm.
+*
+* The nodes of a graph are identified by dense ids. The traversal is
+* iterative, such that the depth of a graph is not limited by the call stack.
+* The scratch buffers are kept between searches, and a search only touches
+* the entries of the nodes it visits. A finder can therefore be reused for
+* many searches in subgraphs of a large graph. A finder is not thread-safe.
+*/
+class sccfinder final {
+	enum : size_t { unvisited = ~size_t(0) };
+
+	struct frame {
+		size_t id;
+		/* The successors of the node in the successor buffer. */
+		size_t begin;
+		size_t next;
+		size_t end;
+	};
+
+public:
+	typedef std::vector<size_t>::const_iterator const_iterator;
+
+	sccfinder() noexcept
+	: nvisited_(0)
+	{}
+
+	sccfinder(const sccfinder&) = delete;
+
+	sccfinder &
+	operator=(const sccfinder&) = delete;
+
+	/**
+	* \brief Finds the components of all nodes reachable from \p root.
+	*
+	* All node ids must be smaller than \p nids. The functor \p successors is
+	* invoked as successors(id, ids) and must append the ids of the successors
+	* of node \p id to the vector \p ids. The functor \p emit is invoked as
+	* emit(first, last) with a range of const_iterators over the ids of every
+	* found component. The components are emitted in reverse topological order, i.e.,
+	* a component is emitted before all components that can reach it.
+	*
+	* Nodes that were visited by a previous search since the last invocation of
+	* clear() are considered to be visited, but are not part of a component of
+	* this search.
+	*/
+	template <class Successors, class Emit> void
+	find(size_t root, size_t nids, const Successors & successors, const Emit & emit)
+	{
+		if (indices_.size() < nids) {
+			indices_.resize(nids, unvisited);
+			lowlinks_.resize(nids);
+			onstack_.resize(nids, false);
+		}
+
+		JLM_DEBUG_ASSERT(root < nids);
+		if (visited(root))
+			return;
+
+		visit(root, successors);
+		while (!frames_.empty()) {
+			auto & f = frames_.back();
+			if (f.next != f.end) {
+				auto id = successors_[f.next++];
+				JLM_DEBUG_ASSERT(id < nids);
+				if (!visited(id)) {
+					visit(id, successors);
+				} else if (onstack_[id]) {
+					/* successor is in stack and hence in the current component */
+					lowlinks_[f.id] = std::min(lowlinks_[f.id], indices_[id]);
+				}
+				continue;
+			}
+
+			auto id = f.id;
+			successors_.resize(f.begin);
+			frames_.pop_back();
+
+			if (lowlinks_[id] == indices_[id]) {
+				auto first = stack_.cend();
+				do {
+					--first;
+					onstack_[*first] = false;
+				} while (*first != id);
+
+				emit(first, stack_.cend());
+				stack_.erase(first, stack_.cend());
+			}
+
+			if (!frames_.empty()) {
+				auto parent = frames_.back().id;
+				lowlinks_[parent] = std::min(lowlinks_[parent], lowlinks_[id]);
+			}
+		}
+	}
+
+	bool
+	visited(size_t id) const noexcept
+	{
+		return id < indices_.size() && indices_[id] != unvisited;
+	}
+
+	/**
+	* \brief Forgets all visited nodes.
+	*
+	* The cost is proportional to the number of visited nodes.
+	*/
+	void
+	clear() noexcept
+	{
+		for (const auto & id : visitedids_)
+			indices_[id] = unvisited;
+
+		visitedids_.clear();
+		nvisited_ = 0;
+	}
+
+private:
+	template <class Successors> void
+	visit(size_t id, const Successors & successors)
+	{
+		indices_[id] = lowlinks_[id] = nvisited_++;
+		onstack_[id] = true;
+		stack_.push_back(id);
+		visitedids_.push_back(id);
+
+		auto begin = successors_.size();
+		successors(id, successors_);
+		frames_.push_back({id, begin, begin, successors_.size()});
+	}
+
+	size_t nvisited_;
+	/* Indexed by node id. */
+	std::vector<size_t> indices_;
+	std::vector<size_t> lowlinks_;
+	std::vector<bool> onstack_;
+
+	std::vector<size_t> stack_;
+	std::vector<frame> frames_;
+	std::vector<size_t> successors_;
+	std::vector<size_t> visitedids_;
+};
+
+}
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_UTIL_SMALL_VECTOR_HPP
+#define JLM_UTIL_SMALL_VECTOR_HPP
+
+#include <jlm/common.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+namespace jlm {
+
+/**
+* \brief A vector that stores up to \p N elements without heap allocation.
+*
+* Only trivially copyable element types are supported. The storage moves to
+* the heap once more than \p N elements are stored.
+*/
+template <class T, size_t N>
+class small_vector final {
+	static_assert(std::is_trivially_copyable<T>::value,
+		"Template parameter T must be trivially copyable.");
+	static_assert(N > 0, "Template parameter N must be larger than zero.");
+
+public:
+	typedef T * iterator;
+	typedef const T * const_iterator;
+
+	~small_vector()
+	{
+		if (data_ != inline_)
+			delete[] data_;
+	}
+
+	small_vector() noexcept
+	: size_(0)
+	, capacity_(N)
+	, data_(inline_)
+	{}
+
+	template <class Iterator>
+	small_vector(Iterator first, Iterator last)
+	: small_vector()
+	{
+		assign(first, last);
+	}
+
+	small_vector(std::initializer_list<T> elements)
+	: small_vector(elements.begin(), elements.end())
+	{}
+
+	small_vector(const small_vector & other)
+	: small_vector(other.begin(), other.end())
+	{}
+
+	small_vector(small_vector && other) noexcept
+	: small_vector()
+	{
+		*this = std::move(other);
+	}
+
+	small_vector &
+	operator=(const small_vector & other)
+	{
+		if (this != &other)
+			assign(other.begin(), other.end());
+
+		return *this;
+	}
+
+	small_vector &
+	operator=(small_vector && other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		if (other.data_ == other.inline_) {
+			std::copy(other.begin(), other.end(), inline_);
+			if (data_ != inline_)
+				delete[] data_;
+			data_ = inline_;
+			capacity_ = N;
+		} else {
+			if (data_ != inline_)
+				delete[] data_;
+			data_ = other.data_;
+			capacity_ = other.capacity_;
+			other.data_ = other.inline_;
+			other.capacity_ = N;
+		}
+
+		size_ = other.size_;
+		other.size_ = 0;
+		return *this;
+	}
+
+	template <class Iterator> void
+	assign(Iterator first, Iterator last)
+	{
+		size_ = 0;
+		reserve(std::distance(first, last));
+		for (; first != last; first++)
+			data_[size_++] = *first;
+	}
+
+	void
+	reserve(size_t capacity)
+	{
+		if (capacity <= capacity_)
+			return;
+
+		auto data = new T[capacity];
+		std::copy(begin(), end(), data);
+		if (data_ != inline_)
+			delete[] data_;
+
+		data_ = data;
+		capacity_ = capacity;
+	}
+
+	void
+	push_back(const T & element)
+	{
+		if (size_ == capacity_)
+			reserve(2*capacity_);
+
+		data_[size_++] = element;
+	}
+
+	void
+	pop_back() noexcept
+	{
+		JLM_DEBUG_ASSERT(size_ != 0);
+		size_--;
+	}
+
+	void
+	clear() noexcept
+	{
+		size_ = 0;
+	}
+
+	size_t
+	size() const noexcept
+	{
+		return size_;
+	}
+
+	bool
+	empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	T &
+	operator[](size_t index) noexcept
+	{
+		JLM_DEBUG_ASSERT(index < size_);
+		return data_[index];
+	}
+
+	const T &
+	operator[](size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < size_);
+		return data_[index];
+	}
+
+	iterator
+	begin() noexcept
+	{
+		return data_;
+	}
+
+	const_iterator
+	begin() const noexcept
+	{
+		return data_;
+	}
+
+	iterator
+	end() noexcept
+	{
+		return data_ + size_;
+	}
+
+	const_iterator
+	end() const noexcept
+	{
+		return data_ + size_;
+	}
+
+	/**
+	* \brief Returns true if the elements are stored inline.
+	*/
+	bool
+	is_inline() const noexcept
+	{
+		return data_ == inline_;
+	}
+
+private:
+	size_t size_;
+	size_t capacity_;
+	T * data_;
+	T inline_[N];
+};
+
+}
+
+#endif
@@ -8,17 +8,130 @@
 
 #include <jlm/util/file.hpp>
 
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 namespace jlm {
 
+enum class statid {
+	  aggregation
+	, annotation
+	, cache
+	, cfr
+	, cne
+	, dne
+	, iln
+	, inv
+	, ivt
+	, module
+	, pll
+	, psh
+	, red
+	, repeat
+	, rvsdg_construction
+	, rvsdg_destruction
+	, rvsdg_optimization
+	, url
+};
+
+/**
+* \brief Returns the name of a stat as used on the command line, e.g. "cne".
+*/
+std::string
+to_str(const statid & id);
+
+/**
+* \brief Returns the stat with name \p name.
+*
+* Throws jlm::error if no stat with this name exists.
+*/
+statid
+to_statid(const std::string & name);
+
+std::vector<statid>
+all_statids();
+
+/**
+* \brief A named field of a stat.
+*
+* Numeric fields are printed unquoted in the JSON format.
+*/
+class statfield final {
+public:
+	statfield(const std::string & name, const std::string & value)
+	: numeric_(false)
+	, name_(name)
+	, value_(value)
+	{}
+
+	statfield(const std::string & name, size_t value)
+	: numeric_(true)
+	, name_(name)
+	, value_(std::to_string(value))
+	{}
+
+	bool
+	numeric() const noexcept
+	{
+		return numeric_;
+	}
+
+	const std::string &
+	name() const noexcept
+	{
+		return name_;
+	}
+
+	const std::string &
+	value() const noexcept
+	{
+		return value_;
+	}
+
+private:
+	bool numeric_;
+	std::string name_;
+	std::string value_;
+};
+
 class stat {
 public:
 	virtual
 	~stat();
 
-	virtual std::string
-	to_str() const = 0;
+	stat(const statid & id)
+	: id_(id)
+	{}
+
+	const statid &
+	id() const noexcept
+	{
+		return id_;
+	}
+
+	/**
+	* \brief Returns the fields of the stat in print order.
+	*/
+	virtual std::vector<statfield>
+	fields() const = 0;
+
+private:
+	statid id_;
 };
 
+/**
+* \brief The format of the stats file.
+*
+* The text format prints one line per stat with an upper case label followed
+* by the space separated field values. The JSON format prints one object per
+* line, and the CSV format prints a header line the first time a stat is
+* printed followed by one line per stat. Both the JSON and CSV format include
+* the peak resident set size of the process in kilobytes.
+*/
+enum class statformat {text, json, csv};
+
 class stats_descriptor final {
 public:
 	stats_descriptor()
@@ -26,26 +139,16 @@ public:
 	{}
 
 	stats_descriptor(const jlm::filepath & path)
-	: print_cfr_time(false)
-	, print_cne_stat(false)
-	, print_dne_stat(false)
-	, print_iln_stat(false)
-	, print_inv_stat(false)
-	, print_ivt_stat(false)
-	, print_pull_stat(false)
-	, print_push_stat(false)
-	, print_reduction_stat(false)
-	, print_unroll_stat(false)
-	, print_annotation_time(false)
-	, print_aggregation_time(false)
-	, print_rvsdg_construction(false)
-	, print_rvsdg_destruction(false)
-	, print_rvsdg_optimization(false)
+	: format_(statformat::json)
 	, file_(path)
 	{
 		file_.open("a");
 	}
 
+	stats_descriptor(const stats_descriptor&) = delete;
+
+	stats_descriptor &
+	operator=(const stats_descriptor&) = delete;
 
 	const jlm::filepath &
 	filepath() const noexcept
@@ -54,36 +157,52 @@ public:
 	}
 
 	void
-	set_file(const jlm::filepath & path) noexcept
+	set_file(const jlm::filepath & path)
 	{
 		file_ = std::move(jlm::file(path));
 		file_.open("a");
 	}
 
+	const statformat &
+	format() const noexcept
+	{
+		return format_;
+	}
+
 	void
-	print_stat(const stat & s) const noexcept
+	set_format(const statformat & format) noexcept
 	{
-		fprintf(file_.fd(), "%s\n", s.to_str().c_str());
+		format_ = format;
 	}
 
-	bool print_cfr_time;
-	bool print_cne_stat;
-	bool print_dne_stat;
-	bool print_iln_stat;
-	bool print_inv_stat;
-	bool print_ivt_stat;
-	bool print_pull_stat;
-	bool print_push_stat;
-	bool print_reduction_stat;
-	bool print_unroll_stat;
-	bool print_annotation_time;
-	bool print_aggregation_time;
-	bool print_rvsdg_construction;
-	bool print_rvsdg_destruction;
-	bool print_rvsdg_optimization;
+	bool
+	is_enabled(const statid & id) const noexcept
+	{
+		return enabled_.find(id) != enabled_.end();
+	}
+
+	void
+	enable(const statid & id)
+	{
+		enabled_.insert(id);
+	}
+
+	void
+	enable_all()
+	{
+		for (const auto & id : all_statids())
+			enable(id);
+	}
+
+	void
+	print_stat(const stat & s) const;
 
 private:
+	statformat format_;
 	jlm::file file_;
+	mutable std::mutex mutex_;
+	std::unordered_set<statid> enabled_;
+	mutable std::unordered_set<statid> csvheaders_;
 };
 
 }
@@ -36,4 +36,35 @@ strfmt(Args... args)
 	return os.str();
 }
 
+/*
+	Returns str as a quoted JSON string. Quotes, backslashes, and control
+	characters are escaped.
+*/
+static inline std::string
+quote_json(const std::string & str)
+{
+	static const char * hex = "0123456789abcdef";
+
+	std::string quoted("\"");
+	for (const auto & c : str) {
+		auto u = static_cast<unsigned char>(c);
+		if (c == '"' || c == '\\') {
+			quoted += '\\';
+			quoted += c;
+		} else if (c == '\n') {
+			quoted += "\\n";
+		} else if (c == '\t') {
+			quoted += "\\t";
+		} else if (u < 0x20) {
+			quoted += "\\u00";
+			quoted += hex[u >> 4];
+			quoted += hex[u & 0xf];
+		} else {
+			quoted += c;
+		}
+	}
+
+	return quoted + "\"";
+}
+
 #endif
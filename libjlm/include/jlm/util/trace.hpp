@@ -0,0 +1,133 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_UTIL_TRACE_HPP
+#define JLM_UTIL_TRACE_HPP
+
+#include <jlm/util/file.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace jlm {
+
+/**
+* \brief Collects trace events of a compilation.
+*
+* The events are written in the Chrome trace-event format and can be
+* inspected with chrome://tracing or other trace viewers. The tracer is
+* disabled by default and trace scopes created while it is disabled record
+* nothing.
+*/
+class tracer final {
+	typedef std::chrono::steady_clock clock;
+
+	class event final {
+	public:
+		std::string name;
+		const char * category;
+		size_t tid;
+		clock::time_point start;
+		clock::time_point end;
+	};
+
+public:
+	tracer(const tracer&) = delete;
+
+	tracer &
+	operator=(const tracer&) = delete;
+
+	static tracer &
+	global() noexcept;
+
+	bool
+	is_enabled() const noexcept
+	{
+		return enabled_;
+	}
+
+	void
+	enable() noexcept
+	{
+		enabled_ = true;
+	}
+
+	void
+	record(
+		const char * category,
+		const std::string & name,
+		const clock::time_point & start,
+		const clock::time_point & end);
+
+	/**
+	* \brief Writes all recorded events to \p path.
+	*
+	* Throws jlm::error if the file cannot be written.
+	*/
+	void
+	write(const jlm::filepath & path) const;
+
+	void
+	clear();
+
+private:
+	tracer();
+
+	bool enabled_;
+	clock::time_point origin_;
+	std::vector<event> events_;
+	mutable std::mutex mutex_;
+	std::unordered_map<std::thread::id, size_t> tids_;
+
+	friend class trace_scope;
+};
+
+/**
+* \brief Records a trace event from its construction until its destruction.
+*
+* Example:
+*    {
+*      jlm::trace_scope scope("pass", "cne");
+*      cne(rm, sd);
+*    }
+*/
+class trace_scope final {
+public:
+	trace_scope(const char * category, const std::string & name)
+	: enabled_(tracer::global().is_enabled())
+	, category_(category)
+	{
+		if (!enabled_)
+			return;
+
+		name_ = name;
+		start_ = tracer::clock::now();
+	}
+
+	~trace_scope()
+	{
+		if (enabled_)
+			tracer::global().record(category_, name_, start_, tracer::clock::now());
+	}
+
+	trace_scope(const trace_scope&) = delete;
+
+	trace_scope &
+	operator=(const trace_scope&) = delete;
+
+private:
+	bool enabled_;
+	std::string name_;
+	const char * category_;
+	tracer::clock::time_point start_;
+};
+
+}
+
+#endif
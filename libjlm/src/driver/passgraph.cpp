@@ -5,8 +5,13 @@
 
 #include <jlm/driver/passgraph.hpp>
 
+#include <condition_variable>
 #include <deque>
+#include <exception>
 #include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 namespace jlm {
 
@@ -62,10 +67,76 @@ passgraph::passgraph()
 }
 
 void
-passgraph::run() const
+passgraph::run(size_t njobs) const
 {
-	for (const auto & node : topsort(this))
-		node->cmd().run();
+	std::mutex mutex;
+	std::condition_variable cv;
+
+	/*
+		Only commands reachable from the entry are run, and a command waits
+		only for its reachable predecessors.
+	*/
+	auto nodes = topsort(this);
+	std::unordered_map<passgraph_node*, size_t> npredecessors;
+	for (const auto & node : nodes) {
+		for (const auto & edge : *node)
+			npredecessors[edge.sink()]++;
+	}
+
+	size_t nrunning = 0, nfinished = 0;
+	std::exception_ptr exception;
+	std::deque<passgraph_node*> ready({entry()});
+
+	auto is_done = [&]()
+	{
+		return nfinished == nodes.size() || (exception && nrunning == 0);
+	};
+
+	auto worker = [&]()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			cv.wait(lock, [&](){ return is_done() || (!exception && !ready.empty()); });
+			if (is_done())
+				break;
+
+			auto node = ready.front();
+			ready.pop_front();
+			nrunning++;
+
+			lock.unlock();
+			std::exception_ptr e;
+			try {
+				node->cmd().run();
+			} catch (...) {
+				e = std::current_exception();
+			}
+			lock.lock();
+
+			nrunning--;
+			nfinished++;
+			if (e && !exception)
+				exception = e;
+
+			for (const auto & edge : *node) {
+				if (--npredecessors[edge.sink()] == 0 && !e)
+					ready.push_back(edge.sink());
+			}
+
+			cv.notify_all();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t n = 1; n < njobs; n++)
+		threads.push_back(std::thread(worker));
+
+	worker();
+	for (auto & thread : threads)
+		thread.join();
+
+	if (exception)
+		std::rethrow_exception(exception);
 }
 
 /* support methods */
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <deque>
+#include <set>
 #include <unordered_map>
 
 namespace jlm {
@@ -131,10 +132,16 @@ is_linear(const cfg_node * node) noexcept
 	return true;
 }
 
+/*
+	The nodes are visited in the order of their indices, such that the
+	aggregation of equal cfgs results in equal trees.
+*/
+typedef std::set<cfg_node*, index_order> nodeset;
+
 static inline jlm::cfg_node *
 reduce_linear(
 	jlm::cfg_node * entry,
-	std::unordered_set<cfg_node*> & to_visit,
+	nodeset & to_visit,
 	std::unordered_map<cfg_node*, std::unique_ptr<aggnode>> & map)
 {
 	/* sanity checks */
@@ -165,7 +172,7 @@ reduce_linear(
 static inline jlm::cfg_node *
 reduce_loop(
 	jlm::cfg_node * node,
-	std::unordered_set<cfg_node*> & to_visit,
+	nodeset & to_visit,
 	std::unordered_map<cfg_node*, std::unique_ptr<aggnode>> & map)
 {
 	/* sanity checks */
@@ -195,7 +202,7 @@ reduce_loop(
 static inline jlm::cfg_node *
 reduce_branch(
 	jlm::cfg_node * split,
-	std::unordered_set<cfg_node*> & to_visit,
+	nodeset & to_visit,
 	std::unordered_map<cfg_node*, std::unique_ptr<aggnode>> & map)
 {
 	/* sanity checks */
@@ -236,7 +243,7 @@ reduce_branch(
 static inline bool
 reduce(
 	jlm::cfg_node * node,
-	std::unordered_set<cfg_node*> & to_visit,
+	nodeset & to_visit,
 	std::unordered_map<cfg_node*, std::unique_ptr<aggnode>> & map)
 {
 	if (is_loop(node)) {
@@ -259,7 +266,7 @@ reduce(
 
 static inline void
 aggregate(
-	std::unordered_set<jlm::cfg_node*> & to_visit,
+	nodeset & to_visit,
 	std::unordered_map<cfg_node*, std::unique_ptr<aggnode>> & map)
 {
 	auto it = to_visit.begin();
@@ -279,7 +286,7 @@ aggregate(jlm::cfg & cfg)
 	auto exit = cfg.exit();
 
 	/* insert all aggregation leaves into the map */
-	std::unordered_set<cfg_node*> to_visit({entry, exit});
+	nodeset to_visit({entry, exit});
 	std::unordered_map<jlm::cfg_node*, std::unique_ptr<aggnode>> map;
 	map[entry] = entryaggnode::create(entry->arguments());
 	map[exit] = exitaggnode::create(exit->results());
@@ -17,26 +17,17 @@ namespace jlm {
 demandset::~demandset()
 {}
 
-static variableset
-intersect(const variableset & vs1, const variableset & vs2)
-{
-	variableset intersect;
-	for (const auto & v : vs1) {
-		if (vs2.find(v) != vs2.end())
-			intersect.insert(v);
-	}
-	return intersect;
-}
-
 /* read-write annotation */
 
+typedef std::shared_ptr<variableindex> indexptr;
+
 static void
-annotaterw(const aggnode * node, demandmap & dm);
+annotaterw(const aggnode * node, demandmap & dm, const indexptr & index);
 
 static void
-annotaterw(const entryaggnode * node, demandmap & dm)
+annotaterw(const entryaggnode * node, demandmap & dm, const indexptr & index)
 {
-	auto ds = demandset::create();
+	auto ds = demandset::create(index);
 	for (const auto & argument : *node)
 		ds->writes.insert(argument);
 
@@ -44,9 +35,9 @@ annotaterw(const entryaggnode * node, demandmap & dm)
 }
 
 static void
-annotaterw(const exitaggnode * node, demandmap & dm)
+annotaterw(const exitaggnode * node, demandmap & dm, const indexptr & index)
 {
-	auto ds = demandset::create();
+	auto ds = demandset::create(index);
 	for (const auto & result : *node)
 		ds->reads.insert(result);
 
@@ -54,87 +45,64 @@ annotaterw(const exitaggnode * node, demandmap & dm)
 }
 
 static void
-annotaterw(const blockaggnode * node, demandmap & dm)
+annotaterw(const blockaggnode * node, demandmap & dm, const indexptr & index)
 {
-	auto & bb = node->tacs();
-
-	auto ds = demandset::create();
-	for (auto it = bb.rbegin(); it != bb.rend(); it++) {
-		auto & tac = *it;
-		if (is<assignment_op>(tac->operation())) {
-			/*
-					We need special treatment for assignment operation, since the variable
-					they assign the value to is modeled as an argument of the tac.
-			*/
-			JLM_DEBUG_ASSERT(tac->noperands() == 2 && tac->nresults() == 0);
-			ds->reads.erase(tac->operand(0));
-			ds->writes.insert(tac->operand(0));
-			ds->reads.insert(tac->operand(1));
-		} else {
-			for (size_t n = 0; n < tac->nresults(); n++) {
-				ds->reads.erase(tac->result(n));
-				ds->writes.insert(tac->result(n));
-			}
-			for (size_t n = 0; n < tac->noperands(); n++)
-				ds->reads.insert(tac->operand(n));
-		}
-	}
-
+	auto ds = demandset::create(index);
+	readwrite(node->tacs(), ds->reads, ds->writes);
 	dm[node] = std::move(ds);
 }
 
 static void
-annotaterw(const linearaggnode * node, demandmap & dm)
+annotaterw(const linearaggnode * node, demandmap & dm, const indexptr & index)
 {
-	auto ds = demandset::create();
+	auto ds = demandset::create(index);
 	for (ssize_t n = node->nchildren()-1; n >= 0; n--) {
 		auto & cs = *dm[node->child(n)];
-		for (const auto & v : cs.writes)
-			ds->reads.erase(v);
-		ds->reads.insert(cs.reads.begin(), cs.reads.end());
-		ds->writes.insert(cs.writes.begin(), cs.writes.end());
+		ds->reads -= cs.writes;
+		ds->reads |= cs.reads;
+		ds->writes |= cs.writes;
 	}
 
 	dm[node] = std::move(ds);
 }
 
 static void
-annotaterw(const branchaggnode * node, demandmap & dm)
+annotaterw(const branchaggnode * node, demandmap & dm, const indexptr & index)
 {
-	auto ds = demandset::create();
+	auto ds = demandset::create(index);
 	ds->reads = dm[node->child(0)]->reads;
 	ds->writes = dm[node->child(0)]->writes;
 	for (size_t n = 1; n < node->nchildren(); n++) {
 		auto & cs = *dm[node->child(n)];
-		ds->writes = intersect(ds->writes, cs.writes);
-		ds->reads.insert(cs.reads.begin(), cs.reads.end());
+		ds->writes &= cs.writes;
+		ds->reads |= cs.reads;
 	}
 
 	dm[node] = std::move(ds);
 }
 
 static void
-annotaterw(const loopaggnode * node, demandmap & dm)
+annotaterw(const loopaggnode * node, demandmap & dm, const indexptr & index)
 {
-	auto ds = demandset::create();
+	auto ds = demandset::create(index);
 	ds->reads = dm[node->child(0)]->reads;
 	ds->writes = dm[node->child(0)]->writes;
 	dm[node] = std::move(ds);
 }
 
 template<class T> static void
-annotaterw(const aggnode * node, demandmap & dm)
+annotaterw(const aggnode * node, demandmap & dm, const indexptr & index)
 {
 	JLM_DEBUG_ASSERT(is<T>(node));
-	annotaterw(static_cast<const T*>(node), dm);
+	annotaterw(static_cast<const T*>(node), dm, index);
 }
 
 static void
-annotaterw(const aggnode * node, demandmap & dm)
+annotaterw(const aggnode * node, demandmap & dm, const indexptr & index)
 {
 	static std::unordered_map<
 		std::type_index,
-		void(*)(const aggnode*, demandmap&)
+		void(*)(const aggnode*, demandmap&, const indexptr&)
 	> map({
 	  {typeid(entryaggnode), annotaterw<entryaggnode>}
 	, {typeid(exitaggnode), annotaterw<exitaggnode>}
@@ -145,10 +113,10 @@ annotaterw(const aggnode * node, demandmap & dm)
 	});
 
 	for (size_t n = 0; n < node->nchildren(); n++)
-		annotaterw(node->child(n), dm);
+		annotaterw(node->child(n), dm, index);
 
 	JLM_DEBUG_ASSERT(map.find(typeid(*node)) != map.end());
-	return map[typeid(*node)](node, dm);
+	return map[typeid(*node)](node, dm, index);
 }
 
 /* demandset annotation */
@@ -164,10 +132,7 @@ annotateds(
 {
 	auto & ds = dm[node];
 	ds->bottom = pds;
-
-	for (const auto & v : ds->writes)
-		pds.erase(v);
-
+	pds -= ds->writes;
 	ds->top = pds;
 }
 
@@ -179,10 +144,7 @@ annotateds(
 {
 	auto & ds = dm[node];
 	ds->bottom = pds;
-
-	for (const auto & v : ds->reads)
-		pds.insert(v);
-
+	pds |= ds->reads;
 	ds->top = pds;
 }
 
@@ -194,11 +156,8 @@ annotateds(
 {
 	auto & ds = dm[node];
 	ds->bottom = pds;
-
-	for (const auto & v : ds->writes)
-		pds.erase(v);
-	pds.insert(ds->reads.begin(), ds->reads.end());
-
+	pds -= ds->writes;
+	pds |= ds->reads;
 	ds->top = pds;
 }
 
@@ -214,10 +173,8 @@ annotateds(
 	for (ssize_t n = node->nchildren()-1; n >= 0; n--)
 		annotateds(node->child(n), pds, dm);
 
-	for (const auto & v : ds->writes)
-		pds.erase(v);
-	pds.insert(ds->reads.begin(), ds->reads.end());
-
+	pds -= ds->writes;
+	pds |= ds->reads;
 	ds->top = pds;
 }
 
@@ -235,10 +192,8 @@ annotateds(
 		annotateds(node->child(n), tmp, dm);
 	}
 
-	for (const auto & v : ds->writes)
-		pds.erase(v);
-	pds.insert(ds->reads.begin(), ds->reads.end());
-
+	pds -= ds->writes;
+	pds |= ds->reads;
 	ds->top = pds;
 }
 
@@ -250,16 +205,16 @@ annotateds(
 {
 	auto & ds = dm[node];
 
-	pds.insert(ds->reads.begin(), ds->reads.end());
+	pds |= ds->reads;
 	ds->bottom = ds->top = pds;
 	annotateds(node->child(0), pds, dm);
 
 	for (const auto & v : ds->reads)
-		JLM_DEBUG_ASSERT(pds.find(v) != pds.end());
+		JLM_DEBUG_ASSERT(pds.contains(v));
 
 	for (const auto & v : ds->writes)
-		if (ds->reads.find(v) == ds->reads.end())
-			JLM_DEBUG_ASSERT(pds.find(v) == pds.end());
+		if (!ds->reads.contains(v))
+			JLM_DEBUG_ASSERT(!pds.contains(v));
 }
 
 template<class T> static void
@@ -298,8 +253,10 @@ demandmap
 annotate(const aggnode & root)
 {
 	demandmap dm;
-	variableset ds;
-	annotaterw(&root, dm);
+	auto index = std::make_shared<variableindex>();
+	annotaterw(&root, dm, index);
+
+	variableset ds(*index);
 	annotateds(&root, ds, dm);
 	return dm;
 }
@@ -5,6 +5,7 @@
 
 #include <jlm/ir/basic-block.hpp>
 #include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
 #include <jlm/ir/operators/operators.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/variable.hpp>
@@ -18,6 +19,12 @@ namespace jlm {
 basic_block::~basic_block()
 {}
 
+void
+basic_block::intern(jlm::tac * tac)
+{
+	tac->intern(cfg().module().operations());
+}
+
 void
 basic_block::insert_before_branch(tacsvector_t & tv)
 {
@@ -30,9 +30,10 @@ cfg_edge::divert(cfg_node * new_sink)
 	if (sink_ == new_sink)
 		return;
 
-	sink_->inedges_.erase(this);
+	source_->cfg().invalidate_structure();
+	sink_->remove_inedge(this);
 	sink_ = new_sink;
-	new_sink->inedges_.insert(this);
+	new_sink->inedges_.push_back(this);
 }
 
 basic_block *
@@ -50,6 +51,43 @@ cfg_edge::split()
 cfg_node::~cfg_node()
 {}
 
+cfg_edge *
+cfg_node::add_outedge(cfg_node * sink)
+{
+	auto edge = cfg().create_edge(this, sink, noutedges());
+	outedges_.push_back(edge);
+	sink->inedges_.push_back(edge);
+	return edge;
+}
+
+void
+cfg_node::remove_outedge(size_t n)
+{
+	JLM_DEBUG_ASSERT(n < noutedges());
+	auto edge = outedges_[n];
+
+	edge->sink()->remove_inedge(edge);
+	for (size_t i = n+1; i < noutedges(); i++) {
+		outedges_[i-1] = outedges_[i];
+		outedges_[i-1]->index_ = outedges_[i-1]->index_-1;
+	}
+	outedges_.pop_back();
+	cfg().destroy_edge(edge);
+}
+
+void
+cfg_node::remove_inedge(cfg_edge * edge) noexcept
+{
+	/*
+		The order of the incoming edges is irrelevant. The edge is therefore
+		replaced by the last edge in order to avoid shifting the others.
+	*/
+	auto it = std::find(inedges_.begin(), inedges_.end(), edge);
+	JLM_DEBUG_ASSERT(it != inedges_.end());
+	*it = inedges_[inedges_.size()-1];
+	inedges_.pop_back();
+}
+
 size_t
 cfg_node::noutedges() const noexcept
 {
@@ -60,7 +98,7 @@ void
 cfg_node::remove_inedges()
 {
 	while (inedges_.size() != 0) {
-		cfg_edge * edge = *inedges_.begin();
+		cfg_edge * edge = inedges_[0];
 		JLM_DEBUG_ASSERT(edge->sink() == this);
 		edge->source()->remove_outedge(edge->index());
 	}
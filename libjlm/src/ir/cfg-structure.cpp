@@ -6,139 +6,289 @@
 #include <jlm/ir/basic-block.hpp>
 #include <jlm/ir/cfg.hpp>
 #include <jlm/ir/cfg-structure.hpp>
+#include <jlm/ir/domtree.hpp>
 #include <jlm/ir/operators/operators.hpp>
+#include <jlm/util/scc.hpp>
 
 #include <algorithm>
 #include <unordered_map>
 
-/* Tarjan's SCC algorithm */
+static inline bool
+is_linear_reduction(const jlm::cfg_node * node) noexcept
+{
+	if (node->noutedges() != 1)
+		return false;
 
-static void
-strongconnect(
-	jlm::cfg_node * node,
-	jlm::cfg_node * exit,
-	std::unordered_map<jlm::cfg_node*, std::pair<size_t,size_t>> & map,
-	std::vector<jlm::cfg_node*> & node_stack,
-	size_t & index,
-	std::vector<std::unordered_set<jlm::cfg_node*>> & sccs)
-{
-	map.emplace(node, std::make_pair(index, index));
-	node_stack.push_back(node);
-	index++;
-
-	if (node != exit) {
-		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-			auto successor = it->sink();
-			if (map.find(successor) == map.end()) {
-				/* successor has not been visited yet; recurse on it */
-				strongconnect(successor, exit, map, node_stack, index, sccs);
-				map[node].second = std::min(map[node].second, map[successor].second);
-			} else if (std::find(node_stack.begin(), node_stack.end(), successor) != node_stack.end()) {
-				/* successor is in stack and hence in the current SCC */
-				map[node].second = std::min(map[node].second, map[successor].first);
+	if (node->outedge(0)->sink()->ninedges() != 1)
+		return false;
+
+	return true;
+}
+
+namespace {
+
+/*
+	The control flow of a cfg in compact form. The structural reductions are
+	performed on it instead of on a copy of the cfg. Nodes are identified by
+	the indices of the cfg nodes, and nodes created by reductions receive the
+	subsequent indices. The graph keeps track of the nodes that are not yet
+	reduced, and of the nodes whose edges were modified since the last
+	invocation of clear_touched().
+*/
+class flowgraph final {
+public:
+	static constexpr size_t none = ~size_t(0);
+
+	flowgraph(const jlm::cfg & cfg)
+	: nalive_(0)
+	, alive_(cfg.nindices(), false)
+	, inedges_(cfg.nindices())
+	, outedges_(cfg.nindices())
+	{
+		auto add = [&](const jlm::cfg_node * node)
+		{
+			for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
+				outedges_[node->index()].push_back(it->sink()->index());
+				inedges_[it->sink()->index()].push_back(node->index());
 			}
+			insert(node->index());
+		};
+
+		add(cfg.entry());
+		add(cfg.exit());
+		for (const auto & node : cfg)
+			add(&node);
+	}
+
+	size_t
+	nnodes() const noexcept
+	{
+		return alive_.size();
+	}
+
+	size_t
+	nalive() const noexcept
+	{
+		return nalive_;
+	}
+
+	bool
+	is_alive(size_t n) const noexcept
+	{
+		return alive_[n];
+	}
+
+	void
+	insert(size_t n)
+	{
+		JLM_DEBUG_ASSERT(!alive_[n]);
+		alive_[n] = true;
+		nalive_++;
+		touched_.push_back(n);
+	}
+
+	void
+	erase(size_t n) noexcept
+	{
+		if (alive_[n]) {
+			alive_[n] = false;
+			nalive_--;
 		}
 	}
 
-	if (map[node].second == map[node].first) {
-		std::unordered_set<jlm::cfg_node*> scc;
-		jlm::cfg_node * w;
-		do {
-			w = node_stack.back();
-			node_stack.pop_back();
-			scc.insert(w);
-		} while (w != node);
+	const std::vector<size_t> &
+	touched() const noexcept
+	{
+		return touched_;
+	}
 
-		if (scc.size() != 1 || (*scc.begin())->has_selfloop_edge())
-			sccs.push_back(scc);
+	void
+	clear_touched() noexcept
+	{
+		touched_.clear();
 	}
-}
 
-static inline std::unique_ptr<jlm::cfg>
-copy_structural(const jlm::cfg & in)
-{
-	JLM_DEBUG_ASSERT(is_valid(in));
+	size_t
+	ninedges(size_t n) const noexcept
+	{
+		return inedges_[n].size();
+	}
+
+	size_t
+	noutedges(size_t n) const noexcept
+	{
+		return outedges_[n].size();
+	}
+
+	const std::vector<size_t> &
+	sources(size_t n) const noexcept
+	{
+		return inedges_[n];
+	}
 
-	std::unique_ptr<jlm::cfg> out(new jlm::cfg(in.module()));
-	out->entry()->remove_outedge(0);
+	const std::vector<size_t> &
+	sinks(size_t n) const noexcept
+	{
+		return outedges_[n];
+	}
+
+	size_t
+	sink(size_t n, size_t index) const noexcept
+	{
+		JLM_DEBUG_ASSERT(index < noutedges(n));
+		return outedges_[n][index];
+	}
+
+	bool
+	has_selfloop_edge(size_t n) const noexcept
+	{
+		return std::find(outedges_[n].begin(), outedges_[n].end(), n) != outedges_[n].end();
+	}
+
+	size_t
+	create()
+	{
+		alive_.push_back(false);
+		inedges_.emplace_back();
+		outedges_.emplace_back();
+		return alive_.size()-1;
+	}
+
+	void
+	add_outedge(size_t source, size_t sink)
+	{
+		outedges_[source].push_back(sink);
+		inedges_[sink].push_back(source);
+		touched_.push_back(source);
+		touched_.push_back(sink);
+	}
 
-	/* create all nodes */
-	std::unordered_map<const jlm::cfg_node*, jlm::cfg_node*> node_map({
-	  {in.entry(), out->entry()}, {in.exit(), out->exit()}
-	});
+	void
+	remove_outedge(size_t source, size_t index)
+	{
+		auto sink = outedges_[source][index];
+		outedges_[source].erase(outedges_[source].begin() + index);
+		remove_inedge(sink, source);
+		touched_.push_back(source);
+		touched_.push_back(sink);
+	}
 
-	for (const auto & node : in) {
-		JLM_DEBUG_ASSERT(jlm::is<jlm::basic_block>(&node));
-		node_map[&node] = jlm::basic_block::create(*out);
+	void
+	remove_outedges(size_t n)
+	{
+		while (noutedges(n) != 0)
+			remove_outedge(n, noutedges(n)-1);
 	}
 
-	/* establish control flow */
-	node_map[in.entry()]->add_outedge(node_map[in.entry()->outedge(0)->sink()]);
-	for (const auto & node : in) {
-		for (auto it = node.begin_outedges(); it != node.end_outedges(); it++)
-			node_map[&node]->add_outedge(node_map[it->sink()]);
+	void
+	remove_inedges(size_t n)
+	{
+		while (ninedges(n) != 0) {
+			auto source = inedges_[n][0];
+			auto it = std::find(outedges_[source].begin(), outedges_[source].end(), n);
+			remove_outedge(source, it - outedges_[source].begin());
+		}
 	}
 
-	return out;
+	void
+	divert_inedges(size_t n, size_t new_sink)
+	{
+		if (n == new_sink)
+			return;
+
+		for (const auto & source : inedges_[n]) {
+			auto & sinks = outedges_[source];
+			*std::find(sinks.begin(), sinks.end(), n) = new_sink;
+			inedges_[new_sink].push_back(source);
+			touched_.push_back(source);
+		}
+		inedges_[n].clear();
+		touched_.push_back(n);
+		touched_.push_back(new_sink);
+	}
+
+private:
+	void
+	remove_inedge(size_t n, size_t source) noexcept
+	{
+		auto & sources = inedges_[n];
+		auto it = std::find(sources.begin(), sources.end(), source);
+		JLM_DEBUG_ASSERT(it != sources.end());
+		*it = sources.back();
+		sources.pop_back();
+	}
+
+	size_t nalive_;
+	std::vector<bool> alive_;
+	std::vector<size_t> touched_;
+	std::vector<std::vector<size_t>> inedges_;
+	std::vector<std::vector<size_t>> outedges_;
+};
+
+constexpr size_t flowgraph::none;
+
 }
 
 static inline bool
-is_loop(const jlm::cfg_node * node) noexcept
+is_loop(const flowgraph & g, size_t node) noexcept
 {
-	return node->ninedges() == 2
-	    && node->noutedges() == 2
-	    && node->has_selfloop_edge();
+	return g.ninedges(node) == 2
+	    && g.noutedges(node) == 2
+	    && g.has_selfloop_edge(node);
 }
 
 static inline bool
-is_linear_reduction(const jlm::cfg_node * node) noexcept
+is_linear_reduction(const flowgraph & g, size_t node) noexcept
 {
-	if (node->noutedges() != 1)
+	if (g.noutedges(node) != 1)
 		return false;
 
-	if (node->outedge(0)->sink()->ninedges() != 1)
+	/* a node whose only edge is a self loop would be reduced to itself */
+	if (g.sink(node, 0) == node)
+		return false;
+
+	if (g.ninedges(g.sink(node, 0)) != 1)
 		return false;
 
 	return true;
 }
 
-static inline jlm::cfg_node *
-find_join(const jlm::cfg_node * split) noexcept
+static inline size_t
+find_join(const flowgraph & g, size_t split) noexcept
 {
-	JLM_DEBUG_ASSERT(split->noutedges() > 1);
-	auto s1 = split->outedge(0)->sink();
-	auto s2 = split->outedge(1)->sink();
+	JLM_DEBUG_ASSERT(g.noutedges(split) > 1);
+	auto s1 = g.sink(split, 0);
+	auto s2 = g.sink(split, 1);
 
-	jlm::cfg_node * join = nullptr;
-	if (s1->noutedges() == 1 && s1->outedge(0)->sink() == s2)
+	auto join = flowgraph::none;
+	if (g.noutedges(s1) == 1 && g.sink(s1, 0) == s2)
 		join = s2;
-	else if (s2->noutedges() == 1 && s2->outedge(0)->sink() == s1)
+	else if (g.noutedges(s2) == 1 && g.sink(s2, 0) == s1)
 		join = s1;
-	else if (s1->noutedges() == 1 && s2->noutedges() == 1
-	     && (s1->outedge(0)->sink() == s2->outedge(0)->sink()))
-		join = s1->outedge(0)->sink();
+	else if (g.noutedges(s1) == 1 && g.noutedges(s2) == 1
+	     && (g.sink(s1, 0) == g.sink(s2, 0)))
+		join = g.sink(s1, 0);
 
 	return join;
 }
 
 static inline bool
-is_branch(const jlm::cfg_node * split) noexcept
+is_branch(const flowgraph & g, size_t split) noexcept
 {
-	if (split->noutedges() < 2)
+	if (g.noutedges(split) < 2)
 		return false;
 
-	auto join = find_join(split);
-	if (join == nullptr || join->ninedges() != split->noutedges())
+	auto join = find_join(g, split);
+	if (join == flowgraph::none || g.ninedges(join) != g.noutedges(split))
 		return false;
 
-	for (auto it = split->begin_outedges(); it != split->end_outedges(); it++) {
-		if (it->sink() == join)
+	for (const auto & node : g.sinks(split)) {
+		if (node == join)
 			continue;
 
-		auto node = it->sink();
-		if (node->ninedges() != 1)
+		if (g.ninedges(node) != 1)
 			return false;
-		if (node->noutedges() != 1 || node->outedge(0)->sink() != join)
+		if (g.noutedges(node) != 1 || g.sink(node, 0) != join)
 			return false;
 	}
 
@@ -146,228 +296,244 @@ is_branch(const jlm::cfg_node * split) noexcept
 }
 
 static inline bool
-is_proper_branch(const jlm::cfg_node * split) noexcept
+is_proper_branch(const flowgraph & g, size_t split) noexcept
 {
-	if (split->noutedges() < 2)
+	if (g.noutedges(split) < 2)
 		return false;
 
-	if (split->outedge(0)->sink()->noutedges() != 1)
+	if (g.noutedges(g.sink(split, 0)) != 1)
 		return false;
 
-	auto join = split->outedge(0)->sink()->outedge(0)->sink();
-	for (auto it = split->begin_outedges(); it != split->end_outedges(); it++) {
-		if (it->sink()->ninedges() != 1)
+	auto join = g.sink(g.sink(split, 0), 0);
+	for (const auto & node : g.sinks(split)) {
+		if (g.ninedges(node) != 1)
 			return false;
-		if (it->sink()->noutedges() != 1)
+		if (g.noutedges(node) != 1)
 			return false;
-		if (it->sink()->outedge(0)->sink() != join)
+		if (g.sink(node, 0) != join)
 			return false;
 	}
 
 	return true;
 }
 
-static inline bool
-is_T1(const jlm::cfg_node * node) noexcept
-{
-	for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-		if (it->source() == it->sink())
-			return true;
-	}
-
-	return false;
-}
-
-static inline bool
-is_T2(const jlm::cfg_node * node) noexcept
+static inline void
+remove_selfloop_edge(flowgraph & g, size_t node)
 {
-	if (node->ninedges() == 0)
-		return false;
-
-	auto source = (*node->begin_inedges())->source();
-	for (auto it = node->begin_inedges(); it != node->end_inedges(); it++) {
-		if ((*it)->source() != source)
-			return false;
-	}
-
-	return true;
+	auto & sinks = g.sinks(node);
+	auto it = std::find(sinks.begin(), sinks.end(), node);
+	g.remove_outedge(node, it - sinks.begin());
 }
 
 static inline void
-reduce_loop(
-	jlm::cfg_node * node,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
-{
-	JLM_DEBUG_ASSERT(is_loop(node));
-	auto & cfg = node->cfg();
-
-	auto reduction = jlm::basic_block::create(cfg);
-	for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-		if (it->is_selfloop()) {
-			node->remove_outedge(it->index());
-			break;
-		}
-	}
+reduce_loop(flowgraph & g, size_t node)
+{
+	JLM_DEBUG_ASSERT(is_loop(g, node));
 
-	reduction->add_outedge(node->outedge(0)->sink());
-	node->remove_outedges();
-	node->divert_inedges(reduction);
+	auto reduction = g.create();
+	remove_selfloop_edge(g, node);
+	g.add_outedge(reduction, g.sink(node, 0));
+	g.remove_outedges(node);
+	g.divert_inedges(node, reduction);
 
-	to_visit.erase(node);
-	to_visit.insert(reduction);
+	g.erase(node);
+	g.insert(reduction);
 }
 
 static inline void
-reduce_linear(
-	jlm::cfg_node * entry,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
+reduce_linear(flowgraph & g, size_t entry)
 {
-	JLM_DEBUG_ASSERT(is_linear_reduction(entry));
-	auto exit = entry->outedge(0)->sink();
-	auto & cfg = entry->cfg();
+	JLM_DEBUG_ASSERT(is_linear_reduction(g, entry));
+	auto exit = g.sink(entry, 0);
 
-	auto reduction = jlm::basic_block::create(cfg);
-	entry->divert_inedges(reduction);
-	for (auto it = exit->begin_outedges(); it != exit->end_outedges(); it++)
-		reduction->add_outedge(it->sink());
-	exit->remove_outedges();
+	auto reduction = g.create();
+	g.divert_inedges(entry, reduction);
+	for (size_t n = 0; n < g.noutedges(exit); n++)
+		g.add_outedge(reduction, g.sink(exit, n));
+	g.remove_outedges(exit);
 
-	to_visit.erase(entry);
-	to_visit.erase(exit);
-	to_visit.insert(reduction);
+	g.erase(entry);
+	g.erase(exit);
+	g.insert(reduction);
 }
 
 static inline void
-reduce_branch(
-	jlm::cfg_node * split,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
-{
-	JLM_DEBUG_ASSERT(is_branch(split));
-	auto join = find_join(split);
-	auto & cfg = split->cfg();
-
-	auto reduction = jlm::basic_block::create(cfg);
-	split->divert_inedges(reduction);
-	reduction->add_outedge(join);
-	for (auto it = split->begin_outedges(); it != split->end_outedges(); it++) {
-		if (it->sink() != join) {
-			it->sink()->remove_outedges();
-			to_visit.erase(it->sink());
+reduce_branch(flowgraph & g, size_t split)
+{
+	JLM_DEBUG_ASSERT(is_branch(g, split));
+	auto join = find_join(g, split);
+
+	auto reduction = g.create();
+	g.divert_inedges(split, reduction);
+	g.add_outedge(reduction, join);
+	auto sinks = g.sinks(split);
+	for (const auto & node : sinks) {
+		if (node != join) {
+			g.remove_outedges(node);
+			g.erase(node);
 		}
 	}
-	split->remove_outedges();
+	g.remove_outedges(split);
 
-	to_visit.erase(split);
-	to_visit.insert(reduction);
+	g.erase(split);
+	g.insert(reduction);
 }
 
 static inline void
-reduce_proper_branch(
-	jlm::cfg_node * split,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
+reduce_proper_branch(flowgraph & g, size_t split)
 {
-	JLM_DEBUG_ASSERT(is_proper_branch(split));
-	auto join = split->outedge(0)->sink()->outedge(0)->sink();
+	JLM_DEBUG_ASSERT(is_proper_branch(g, split));
+	auto join = g.sink(g.sink(split, 0), 0);
 
-	auto reduction = jlm::basic_block::create(split->cfg());
-	split->divert_inedges(reduction);
-	join->remove_inedges();
-	reduction->add_outedge(join);
-	for (auto it = split->begin_outedges(); it != split->end_outedges(); it++)
-		to_visit.erase(it->sink());
+	auto reduction = g.create();
+	g.divert_inedges(split, reduction);
+	g.remove_inedges(join);
+	g.add_outedge(reduction, join);
+	for (const auto & node : g.sinks(split))
+		g.erase(node);
 
-	to_visit.erase(split);
-	to_visit.insert(reduction);
+	g.erase(split);
+	g.insert(reduction);
 }
 
-static inline void
-reduce_T1(jlm::cfg_node * node)
+static inline bool
+reduce_proper_structured(flowgraph & g, size_t node)
 {
-	JLM_DEBUG_ASSERT(is_T1(node));
+	if (is_loop(g, node)) {
+		reduce_loop(g, node);
+		return true;
+	}
 
-	for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-		if (it->source() == it->sink()) {
-			node->remove_outedge(it->index());
-			break;
-		}
+	if (is_proper_branch(g, node)) {
+		reduce_proper_branch(g, node);
+		return true;
 	}
-}
 
-static inline void
-reduce_T2(
-	jlm::cfg_node * node,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
-{
-	JLM_DEBUG_ASSERT(is_T2(node));
+	if (is_linear_reduction(g, node)) {
+		reduce_linear(g, node);
+		return true;
+	}
 
-	auto p = (*node->begin_inedges())->source();
-	p->divert_inedges(node);
-	p->remove_outedges();
-	to_visit.erase(p);
+	return false;
 }
 
 static inline bool
-reduce_proper_structured(
-	jlm::cfg_node * node,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
+reduce_structured(flowgraph & g, size_t node)
 {
-	if (is_loop(node)) {
-		reduce_loop(node, to_visit);
+	if (is_loop(g, node)) {
+		reduce_loop(g, node);
 		return true;
 	}
 
-	if (is_proper_branch(node)) {
-		reduce_proper_branch(node, to_visit);
+	if (is_branch(g, node)) {
+		reduce_branch(g, node);
 		return true;
 	}
 
-	if (is_linear_reduction(node)) {
-		reduce_linear(node, to_visit);
+	if (is_linear_reduction(g, node)) {
+		reduce_linear(g, node);
 		return true;
 	}
 
 	return false;
 }
 
-static inline bool
-reduce_structured(
-	jlm::cfg_node * node,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
+/*
+	Applies the reductions of \p f until none of them is applicable anymore,
+	and returns true if the cfg was reduced to a single node. Whether a
+	reduction is applicable to a node only depends on the node, its
+	successors, and the successors of its successors. After a reduction, it
+	suffices therefore to revisit the nodes with modified edges and their
+	predecessors up to a distance of two.
+*/
+template <class F> static bool
+reduce(const jlm::cfg & cfg, const F & f)
 {
-	if (is_loop(node)) {
-		reduce_loop(node, to_visit);
-		return true;
-	}
+	flowgraph g(cfg);
 
-	if (is_branch(node)) {
-		reduce_branch(node, to_visit);
-		return true;
+	std::vector<size_t> worklist;
+	std::vector<bool> onworklist(g.nnodes(), false);
+	auto push = [&](size_t node)
+	{
+		if (node >= onworklist.size())
+			onworklist.resize(node+1, false);
+
+		if (!onworklist[node]) {
+			onworklist[node] = true;
+			worklist.push_back(node);
+		}
+	};
+
+	for (size_t n = 0; n < g.nnodes(); n++) {
+		if (g.is_alive(n))
+			push(n);
 	}
+	g.clear_touched();
 
-	if (is_linear_reduction(node)) {
-		reduce_linear(node, to_visit);
-		return true;
+	std::vector<size_t> touched;
+	while (!worklist.empty()) {
+		auto node = worklist.back();
+		worklist.pop_back();
+		onworklist[node] = false;
+
+		if (!g.is_alive(node) || !f(g, node))
+			continue;
+
+		touched = g.touched();
+		g.clear_touched();
+		for (const auto & n : touched) {
+			push(n);
+			for (const auto & p : g.sources(n)) {
+				push(p);
+				for (const auto & pp : g.sources(p))
+					push(pp);
+			}
+		}
 	}
 
-	return false;
+	return g.nalive() == 1;
 }
 
-static inline bool
-reduce_reducible(
-	jlm::cfg_node * node,
-	std::unordered_set<jlm::cfg_node*> & to_visit)
+/*
+	A cfg is reducible if all its nodes are reachable, and it becomes acyclic
+	after the removal of all back edges, i.e., of all edges whose sink
+	dominates their source.
+*/
+static bool
+compute_reducible(const jlm::cfg & cfg)
 {
-	if (is_T1(node)) {
-		reduce_T1(node);
-		return true;
+	using namespace jlm;
+
+	dominators doms(cfg);
+	auto & nodes = doms.preorder();
+	if (nodes.size() != cfg.nnodes()+2)
+		return false;
+
+	std::vector<size_t> npredecessors(cfg.nindices(), 0);
+	for (const auto & node : nodes) {
+		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
+			if (!doms.dominates(it->sink(), node))
+				npredecessors[it->sink()->index()]++;
+		}
 	}
 
-	if (is_T2(node)) {
-		reduce_T2(node, to_visit);
-		return true;
+	size_t nvisited = 0;
+	std::vector<const cfg_node*> worklist({cfg.entry()});
+	while (!worklist.empty()) {
+		auto node = worklist.back();
+		worklist.pop_back();
+		nvisited++;
+
+		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
+			if (doms.dominates(it->sink(), node))
+				continue;
+
+			if (--npredecessors[it->sink()->index()] == 0)
+				worklist.push_back(it->sink());
+		}
 	}
 
-	return false;
+	return nvisited == nodes.size();
 }
 
 namespace jlm {
@@ -488,56 +654,83 @@ is_linear(const jlm::cfg & cfg)
 }
 
 std::vector<std::unordered_set<cfg_node*>>
-find_sccs(const jlm::cfg & cfg)
+find_sccs(cfg_node * entry, cfg_node * exit, sccfinder & finder)
 {
-	JLM_DEBUG_ASSERT(is_closed(cfg));
+	auto & cfg = entry->cfg();
+
+	auto successors = [&](size_t id, std::vector<size_t> & ids)
+	{
+		auto node = cfg.node(id);
+		if (node == exit)
+			return;
+
+		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++)
+			ids.push_back(it->sink()->index());
+	};
 
-	size_t index = 0;
-	std::vector<cfg_node*> node_stack;
 	std::vector<std::unordered_set<cfg_node*>> sccs;
-	std::unordered_map<cfg_node*, std::pair<size_t,size_t>> map;
-	strongconnect(cfg.entry(), cfg.exit(), map, node_stack, index, sccs);
+	auto emit = [&](sccfinder::const_iterator first, sccfinder::const_iterator last)
+	{
+		if (std::distance(first, last) == 1 && !cfg.node(*first)->has_selfloop_edge())
+			return;
+
+		std::unordered_set<cfg_node*> scc;
+		for (auto it = first; it != last; it++)
+			scc.insert(cfg.node(*it));
+
+		sccs.push_back(std::move(scc));
+	};
+
+	finder.clear();
+	finder.find(entry->index(), cfg.nindices(), successors, emit);
 
 	return sccs;
 }
 
-static inline bool
-reduce(
-	const jlm::cfg & cfg,
-	const std::function<bool(jlm::cfg_node*, std::unordered_set<jlm::cfg_node*>&)> & f)
+std::vector<std::unordered_set<cfg_node*>>
+find_sccs(const jlm::cfg & cfg)
 {
 	JLM_DEBUG_ASSERT(is_closed(cfg));
-	auto c = copy_structural(cfg);
 
-	std::unordered_set<cfg_node*> to_visit({c->entry(), c->exit()});
-	for (auto & node : *c)
-		to_visit.insert(&node);
+	sccfinder finder;
+	return find_sccs(cfg.entry(), cfg.exit(), finder);
+}
+
+/* cfg structure */
 
-	auto it = to_visit.begin();
-	while (it != to_visit.end()) {
-		bool reduced = f(*it, to_visit);
-		it = reduced ? to_visit.begin() : std::next(it);
-	}
+cfg_structure::cfg_structure(const jlm::cfg & cfg)
+: reducible_(compute_reducible(cfg))
+, structured_(reduce(cfg, reduce_structured))
+, proper_structured_(reduce(cfg, reduce_proper_structured))
+{}
+
+const cfg_structure &
+structure(const jlm::cfg & cfg)
+{
+	JLM_DEBUG_ASSERT(is_closed(cfg));
+
+	if (!cfg.structure_)
+		cfg.structure_ = std::make_unique<cfg_structure>(cfg);
 
-	return to_visit.size() == 1;
+	return *cfg.structure_;
 }
 
 bool
 is_structured(const jlm::cfg & cfg)
 {
-	return reduce(cfg, reduce_structured);
+	return structure(cfg).is_structured();
 }
 
 bool
 is_proper_structured(const jlm::cfg & cfg)
 {
-	return reduce(cfg, reduce_proper_structured);
+	return structure(cfg).is_proper_structured();
 }
 
 bool
 is_reducible(const jlm::cfg & cfg)
 {
-	return reduce(cfg, reduce_reducible);
+	return structure(cfg).is_reducible();
 }
 
 void
@@ -663,7 +856,7 @@ update_phi_operands(
 	const std::unordered_set<cfg_node*> & deadnodes)
 {
 	for (auto & sink : sinks) {
-		for (auto & tac : *sink) {
+		for (const auto & tac : *sink) {
 			if (!is<phi_op>(tac))
 				break;
 
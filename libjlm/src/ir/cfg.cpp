@@ -15,6 +15,8 @@
 
 #include <algorithm>
 #include <deque>
+#include <new>
+#include <type_traits>
 #include <sstream>
 #include <unordered_map>
 
@@ -36,14 +38,54 @@ exit_node::~exit_node()
 
 /* cfg */
 
+cfg::~cfg()
+{}
+
 cfg::cfg(ipgraph_module & im)
-: module_(im)
+: edgepool_(4096)
+, nnodes_(0)
+, module_(im)
 {
 	entry_ = std::unique_ptr<entry_node>(new entry_node(*this));
 	exit_ = std::unique_ptr<exit_node>(new exit_node(*this));
+	entry_->index_ = 0;
+	exit_->index_ = 1;
 	entry_->add_outedge(exit_.get());
 }
 
+basic_block *
+cfg::add_node(std::unique_ptr<basic_block> bb)
+{
+	invalidate_structure();
+	bb->index_ = nindices();
+	nodes_.push_back(std::move(bb));
+	nnodes_++;
+	return nodes_.back().get();
+}
+
+cfg::iterator
+cfg::find_node(basic_block * bb)
+{
+	if (&bb->cfg() != this || node(bb->index()) != bb)
+		return end();
+
+	return iterator(nodes_.begin() + (bb->index()-2), nodes_.end());
+}
+
+cfg_node *
+cfg::node(size_t index) const noexcept
+{
+	JLM_DEBUG_ASSERT(index < nindices());
+
+	if (index == 0)
+		return entry();
+
+	if (index == 1)
+		return exit();
+
+	return nodes_[index-2].get();
+}
+
 cfg::iterator
 cfg::remove_node(cfg::iterator & it)
 {
@@ -54,13 +96,60 @@ cfg::remove_node(cfg::iterator & it)
 		throw jlm::error("cannot remove node. It has still incoming edges.");
 
 	it->remove_outedges();
-	std::unique_ptr<basic_block> tmp(it.node());
-	auto rit = iterator(std::next(nodes_.find(tmp)));
-	nodes_.erase(tmp);
-	tmp.release();
+
+	/*
+		The slot of the node is left empty, such that the indices of all
+		other nodes stay valid.
+	*/
+	invalidate_structure();
+	auto index = it->index();
+	auto rit = it;
+	++rit;
+	nodes_[index-2].reset();
+	nnodes_--;
 	return rit;
 }
 
+void
+cfg::compact()
+{
+	if (nodes_.size() == nnodes_)
+		return;
+
+	invalidate_structure();
+	nodes_.erase(std::remove(nodes_.begin(), nodes_.end(), nullptr), nodes_.end());
+	for (size_t n = 0; n < nodes_.size(); n++)
+		nodes_[n]->index_ = n+2;
+}
+
+void
+cfg::invalidate_structure() noexcept
+{
+	structure_.reset();
+}
+
+cfg_edge *
+cfg::create_edge(cfg_node * source, cfg_node * sink, size_t index)
+{
+	static_assert(std::is_trivially_destructible<cfg_edge>::value,
+		"Edges are never destructed.");
+
+	invalidate_structure();
+	if (freeedges_.empty())
+		return edgepool_.create<cfg_edge>(source, sink, index);
+
+	auto edge = freeedges_.back();
+	freeedges_.pop_back();
+	return new (edge) cfg_edge(source, sink, index);
+}
+
+void
+cfg::destroy_edge(cfg_edge * edge)
+{
+	invalidate_structure();
+	freeedges_.push_back(edge);
+}
+
 /* supporting functions */
 
 std::vector<cfg_node*>
@@ -68,28 +157,31 @@ postorder(const jlm::cfg & cfg)
 {
 	JLM_DEBUG_ASSERT(is_closed(cfg));
 
-	std::function<void(
-		cfg_node*,
-		std::unordered_set<cfg_node*>&,
-		std::vector<cfg_node*>&
-	)> traverse = [&](
-		cfg_node * node,
-		std::unordered_set<cfg_node*> & visited,
-		std::vector<cfg_node*> & nodes)
-	{
-		visited.insert(node);
-		for (size_t n = 0; n < node->noutedges(); n++) {
-			auto edge = node->outedge(n);
-			if (visited.find(edge->sink()) == visited.end())
-				traverse(edge->sink(), visited, nodes);
+	/*
+		The stack holds the nodes of the current path together with the index
+		of their next outedge to visit, such that deep cfgs cannot overflow
+		the call stack.
+	*/
+	std::vector<cfg_node*> nodes;
+	std::vector<bool> visited(cfg.nindices(), false);
+	std::vector<std::pair<cfg_node*, size_t>> stack({{cfg.entry(), 0}});
+	visited[cfg.entry()->index()] = true;
+	while (!stack.empty()) {
+		auto node = stack.back().first;
+		auto n = stack.back().second;
+		if (n == node->noutedges()) {
+			nodes.push_back(node);
+			stack.pop_back();
+			continue;
 		}
 
-		nodes.push_back(node);
-	};
-
-	std::vector<cfg_node*> nodes;
-	std::unordered_set<cfg_node*> visited;
-	traverse(cfg.entry(), visited, nodes);
+		stack.back().second++;
+		auto sink = node->outedge(n)->sink();
+		if (!visited[sink->index()]) {
+			visited[sink->index()] = true;
+			stack.push_back({sink, 0});
+		}
+	}
 
 	return nodes;
 }
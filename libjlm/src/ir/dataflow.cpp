@@ -0,0 +1,157 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/dataflow.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/tac.hpp>
+
+namespace jlm {
+
+void
+readwrite(const taclist & tacs, variableset & reads, variableset & writes)
+{
+	for (auto it = tacs.rbegin(); it != tacs.rend(); it++) {
+		auto tac = *it;
+		if (is<assignment_op>(tac->operation())) {
+			/*
+				We need special treatment for assignment operation, since the variable
+				they assign the value to is modeled as an argument of the tac.
+			*/
+			JLM_DEBUG_ASSERT(tac->noperands() == 2 && tac->nresults() == 0);
+			reads.erase(tac->operand(0));
+			writes.insert(tac->operand(0));
+			reads.insert(tac->operand(1));
+			continue;
+		}
+
+		for (size_t n = 0; n < tac->nresults(); n++) {
+			reads.erase(tac->result(n));
+			writes.insert(tac->result(n));
+		}
+
+		if (is<phi_op>(tac->operation()))
+			continue;
+
+		for (size_t n = 0; n < tac->noperands(); n++)
+			reads.insert(tac->operand(n));
+	}
+}
+
+/* dataflow */
+
+dataflow::dataflow(
+	const jlm::cfg & cfg,
+	const direction & d,
+	const meet & m,
+	size_t nbits)
+: cfg_(cfg)
+, direction_(d)
+, meet_(m)
+, nbits_(nbits)
+, gen_(cfg.nindices())
+, kill_(cfg.nindices())
+, in_(cfg.nindices())
+, out_(cfg.nindices())
+{}
+
+bitvector &
+dataflow::gen(const cfg_node * node) noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return gen_[node->index()];
+}
+
+bitvector &
+dataflow::kill(const cfg_node * node) noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return kill_[node->index()];
+}
+
+const bitvector &
+dataflow::in(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return in_[node->index()];
+}
+
+const bitvector &
+dataflow::out(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return out_[node->index()];
+}
+
+size_t
+dataflow::solve()
+{
+	bool forward = direction_ == direction::forward;
+	auto & before = forward ? in_ : out_;
+	auto & after = forward ? out_ : in_;
+	auto boundary = forward ? static_cast<const cfg_node*>(cfg_.entry()) : cfg_.exit();
+	auto nodes = forward ? reverse_postorder(cfg_) : postorder(cfg_);
+
+	/*
+		The meet of an intersection problem starts from the full set, such that
+		nodes that were not visited yet do not restrict the result.
+	*/
+	bitvector top;
+	if (meet_ == meet::intersect) {
+		for (size_t n = 0; n < nbits_; n++)
+			top.insert(n);
+	}
+
+	for (size_t n = 0; n < after.size(); n++)
+		after[n] = top;
+
+	auto compute_meet = [&](const cfg_node * node)
+	{
+		bool first = true;
+		bitvector result;
+		auto combine = [&](const cfg_node * other)
+		{
+			if (first) result = after[other->index()];
+			else if (meet_ == meet::unite) result |= after[other->index()];
+			else result &= after[other->index()];
+			first = false;
+		};
+
+		if (forward) {
+			for (auto it = node->begin_inedges(); it != node->end_inedges(); it++)
+				combine((*it)->source());
+		} else {
+			for (auto it = node->begin_outedges(); it != node->end_outedges(); it++)
+				combine(it->sink());
+		}
+
+		return result;
+	};
+
+	size_t niterations = 0;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		niterations++;
+
+		for (const auto & node : nodes) {
+			auto index = node->index();
+			before[index] = node == boundary ? boundary_ : compute_meet(node);
+
+			auto result = before[index];
+			result -= kill_[index];
+			result |= gen_[index];
+			if (result != after[index]) {
+				after[index] = std::move(result);
+				changed = true;
+			}
+		}
+	}
+
+	return niterations;
+}
+
+}
@@ -8,8 +8,7 @@
 #include <jlm/ir/cfg-structure.hpp>
 #include <jlm/ir/domtree.hpp>
 
-#include <functional>
-#include <unordered_map>
+#include <algorithm>
 
 namespace jlm {
 
@@ -26,119 +25,214 @@ domnode::add_child(std::unique_ptr<domnode> child)
 	return c;
 }
 
-/* dominator computations */
+/* dominators class */
 
-static std::unique_ptr<domnode>
-build_domtree(
-	std::unordered_map<cfg_node*, cfg_node*> & doms,
-	cfg_node * root)
+constexpr size_t dominators::unreachable;
+
+dominators::dominators(const jlm::cfg & cfg)
+: cfg_(cfg)
 {
-	std::function<domnode*(cfg_node*, std::unordered_map<cfg_node*, domnode*>&)> build = [&](
-		cfg_node * node,
-		std::unordered_map<cfg_node*, domnode*> & map)
-	{
-		if (map.find(node) != map.end())
-			return map[node];
+	JLM_DEBUG_ASSERT(is_closed(cfg));
+
+	/*
+		Number the reachable nodes in depth-first preorder. The root is its own
+		parent, such that it is never considered to be linked in eval().
+	*/
+	std::vector<cfg_node*> vertices;
+	std::vector<size_t> parents;
+	std::vector<size_t> dfsnumbers(cfg.nindices(), unreachable);
+	std::vector<std::pair<cfg_node*, size_t>> stack({{cfg.entry(), 0}});
+	while (!stack.empty()) {
+		auto node = stack.back().first;
+		auto parent = stack.back().second;
+		stack.pop_back();
+		if (dfsnumbers[node->index()] != unreachable)
+			continue;
+
+		dfsnumbers[node->index()] = vertices.size();
+		vertices.push_back(node);
+		parents.push_back(parent);
+		for (size_t n = node->noutedges(); n > 0; n--) {
+			auto sink = node->outedge(n-1)->sink();
+			if (dfsnumbers[sink->index()] == unreachable)
+				stack.push_back({sink, dfsnumbers[node->index()]});
+		}
+	}
 
-		auto parent = build(doms[node], map);
-		auto child = parent->add_child(domnode::create(node));
-		map[node] = child;
-		return child ;
+	/*
+		Loukas Georgiadis - Linear-Time Algorithms for Dominators and Related
+		Problems, Semi-NCA
+	*/
+	auto nvertices = vertices.size();
+	std::vector<size_t> semis(nvertices);
+	std::vector<size_t> labels(nvertices);
+	std::vector<size_t> ancestors(parents);
+	for (size_t n = 0; n < nvertices; n++)
+		semis[n] = labels[n] = n;
+
+	/*
+		Returns the vertex with minimal semidominator on the path from v to its
+		last linked ancestor. All vertices with a number of at least lastlinked
+		are linked to their parents.
+	*/
+	std::vector<size_t> path;
+	auto eval = [&](size_t v, size_t lastlinked)
+	{
+		if (ancestors[v] < lastlinked)
+			return labels[v];
+
+		do {
+			path.push_back(v);
+			v = ancestors[v];
+		} while (ancestors[v] >= lastlinked);
+
+		auto p = v;
+		auto plabel = labels[p];
+		do {
+			v = path.back();
+			path.pop_back();
+			ancestors[v] = ancestors[p];
+			if (semis[plabel] < semis[labels[v]])
+				labels[v] = plabel;
+			else
+				plabel = labels[v];
+			p = v;
+		} while (!path.empty());
+
+		return labels[v];
 	};
 
-	auto & cfg = root->cfg();
+	for (size_t w = nvertices-1; w > 0; w--) {
+		semis[w] = parents[w];
+		auto node = vertices[w];
+		for (auto it = node->begin_inedges(); it != node->end_inedges(); it++) {
+			auto v = dfsnumbers[(*it)->source()->index()];
+			if (v == unreachable)
+				continue;
+
+			semis[w] = std::min(semis[w], semis[eval(v, w+1)]);
+		}
+	}
+
+	std::vector<size_t> idoms(parents);
+	for (size_t w = 1; w < nvertices; w++) {
+		while (idoms[w] > semis[w])
+			idoms[w] = idoms[idoms[w]];
+	}
+
+	/*
+		Renumber the vertices in preorder of the dominator tree.
+	*/
+	std::vector<size_t> offsets(nvertices+1, 0);
+	for (size_t w = 1; w < nvertices; w++)
+		offsets[idoms[w]+1]++;
+	for (size_t n = 1; n <= nvertices; n++)
+		offsets[n] += offsets[n-1];
+
+	std::vector<size_t> children(offsets.back());
+	std::vector<size_t> positions(offsets.begin(), offsets.end()-1);
+	for (size_t w = 1; w < nvertices; w++)
+		children[positions[idoms[w]]++] = w;
+
+	numbers_.resize(cfg.nindices(), unreachable);
+	nodes_.reserve(nvertices);
+	idoms_.reserve(nvertices);
+	std::vector<size_t> worklist({0});
+	while (!worklist.empty()) {
+		auto w = worklist.back();
+		worklist.pop_back();
+
+		auto node = vertices[w];
+		numbers_[node->index()] = nodes_.size();
+		idoms_.push_back(w == 0 ? 0 : numbers_[vertices[idoms[w]]->index()]);
+		nodes_.push_back(node);
+
+		for (size_t n = offsets[w+1]; n > offsets[w]; n--)
+			worklist.push_back(children[n-1]);
+	}
+
+	sizes_.resize(nvertices, 1);
+	for (size_t n = nvertices-1; n > 0; n--)
+		sizes_[idoms_[n]] += sizes_[n];
+}
+
+cfg_node *
+dominators::idom(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+
+	auto number = numbers_[node->index()];
+	if (number == unreachable || number == 0)
+		return nullptr;
+
+	return nodes_[idoms_[number]];
+}
+
+bool
+dominators::is_reachable(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return numbers_[node->index()] != unreachable;
+}
 
-	/* find leaves of tree */
-	/* FIXME */
-	std::unordered_set<cfg_node*> nodes({cfg.entry(), cfg.exit()});
-	for (auto & node : cfg)
-		nodes.insert(&node);
-	for (auto & node : cfg)
-		nodes.erase(doms[&node]);
+bool
+dominators::dominates(const cfg_node * n1, const cfg_node * n2) const noexcept
+{
+	JLM_DEBUG_ASSERT(&n1->cfg() == &cfg_ && &n2->cfg() == &cfg_);
 
-	/* build tree bottom-up */
-	std::unordered_map<cfg_node*, domnode*> map;
-	auto domroot = domnode::create(root);
-	map[root] = domroot.get();
-	for (auto node : nodes)
-		build(node, map);
+	auto number1 = numbers_[n1->index()];
+	auto number2 = numbers_[n2->index()];
+	if (number1 == unreachable || number2 == unreachable)
+		return false;
 
-	return domroot;
+	return number1 <= number2 && number2 < number1 + sizes_[number1];
 }
 
-static cfg_node *
-intersect(cfg_node * b1, cfg_node * b2,
-	const std::unordered_map<cfg_node*, size_t> & indices,
-	const std::unordered_map<cfg_node*, cfg_node*> & doms)
+std::vector<cfg_node*>
+dominators::frontier(const cfg_node * node) const
 {
-	while (indices.at(b1) != indices.at(b2)) {
-		while (indices.at(b1) < indices.at(b2))
-			b1 = doms.at(b1);
-		while (indices.at(b2) < indices.at(b1))
-			b2 = doms.at(b2);
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+
+	auto number = numbers_[node->index()];
+	if (number == unreachable)
+		return {};
+
+	std::vector<cfg_node*> frontier;
+	for (size_t n = number; n < number + sizes_[number]; n++) {
+		for (auto it = nodes_[n]->begin_outedges(); it != nodes_[n]->end_outedges(); it++) {
+			if (!strictly_dominates(node, it->sink()))
+				frontier.push_back(it->sink());
+		}
 	}
 
-	return b1;
+	std::sort(frontier.begin(), frontier.end(), [](const cfg_node * n1, const cfg_node * n2)
+	{
+		return n1->index() < n2->index();
+	});
+	frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+
+	return frontier;
 }
 
-/*
-	Keith D. Cooper et. al. - A Simple, Fast Dominance Algorithm
-*/
+/* dominator tree */
+
 std::unique_ptr<domnode>
 domtree(jlm::cfg & cfg)
 {
-	JLM_DEBUG_ASSERT(is_closed(cfg));
+	dominators doms(cfg);
 
-	std::unordered_map<cfg_node*, cfg_node*> doms({
-		{cfg.entry(), cfg.entry()}, {cfg.exit(), nullptr}
-	});
-	for (auto & node : cfg)
-		doms[&node] = nullptr;
-
-	size_t index = cfg.nnodes()+2;
-	auto rporder = reverse_postorder(cfg);
-	std::unordered_map<cfg_node*, size_t> indices;
-	for(auto & node : rporder)
-		indices[node] = index--;
-	JLM_DEBUG_ASSERT(index == 0);
-
-	bool changed = true;
-	while (changed) {
-		changed = false;
-		for (auto & node : rporder) {
-			if (node == cfg.entry())
-				continue;
+	std::vector<domnode*> dnodes(cfg.nindices(), nullptr);
+	auto root = domnode::create(cfg.entry());
+	dnodes[cfg.entry()->index()] = root.get();
+	for (const auto & node : doms.preorder()) {
+		if (node == cfg.entry())
+			continue;
 
-			/* find first processed predecessor */
-			cfg_node * newidom = nullptr;
-			for (auto it = node->begin_inedges(); it != node->end_inedges(); it++) {
-				auto p = (*it)->source();
-				if (doms[p] != nullptr) {
-					newidom = p;
-					break;
-				}
-			}
-			JLM_DEBUG_ASSERT(newidom != nullptr);
-
-			auto pred = newidom;
-			for (auto it = node->begin_inedges(); it != node->end_inedges(); it++) {
-				auto p = (*it)->source();
-				if (p == pred)
-					continue;
-
-				if (doms[p] != nullptr)
-					newidom = intersect(p, newidom, indices, doms);
-			}
-
-			if (doms[node] != newidom) {
-				doms[node] = newidom;
-				changed = true;
-			}
-		}
+		auto parent = dnodes[doms.idom(node)->index()];
+		dnodes[node->index()] = parent->add_child(domnode::create(node));
 	}
 
-	doms[cfg.entry()] = nullptr;
-	return build_domtree(doms, cfg.entry());
+	return root;
 }
 
 }
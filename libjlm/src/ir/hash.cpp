@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/hash.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/types.hpp>
+
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/operation.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/types/bitstring/type.h>
+#include <jive/types/function.h>
+
+#include <llvm/ADT/APFloat.h>
+
+#include <functional>
+#include <string>
+#include <typeinfo>
+
+namespace jlm {
+
+size_t
+hash(const jive::type & type)
+{
+	auto h = typeid(type).hash_code();
+
+	if (auto t = dynamic_cast<const jive::bittype*>(&type))
+		return hash_combine(h, t->nbits());
+
+	if (auto t = dynamic_cast<const jive::ctltype*>(&type))
+		return hash_combine(h, t->nalternatives());
+
+	if (auto t = dynamic_cast<const jive::fcttype*>(&type)) {
+		h = hash_combine(h, t->narguments());
+		for (size_t n = 0; n < t->narguments(); n++)
+			h = hash_combine(h, hash(t->argument_type(n)));
+		for (size_t n = 0; n < t->nresults(); n++)
+			h = hash_combine(h, hash(t->result_type(n)));
+		return h;
+	}
+
+	if (auto t = dynamic_cast<const ptrtype*>(&type))
+		return hash_combine(h, hash(t->pointee_type()));
+
+	if (auto t = dynamic_cast<const arraytype*>(&type))
+		return hash_combine(hash_combine(h, hash(t->element_type())), t->nelements());
+
+	if (auto t = dynamic_cast<const fptype*>(&type))
+		return hash_combine(h, static_cast<size_t>(t->size()));
+
+	if (auto t = dynamic_cast<const vectortype*>(&type))
+		return hash_combine(hash_combine(h, hash(t->type())), t->size());
+
+	if (auto t = dynamic_cast<const structtype*>(&type)) {
+		h = hash_combine(h, std::hash<std::string>()(t->name()));
+		h = hash_combine(h, t->packed());
+		return hash_combine(h, std::hash<const void*>()(t->declaration()));
+	}
+
+	return h;
+}
+
+size_t
+hash(const jive::simple_op & operation)
+{
+	auto h = hash_combine(typeid(operation).hash_code(), operation.narguments());
+	for (size_t n = 0; n < operation.narguments(); n++)
+		h = hash_combine(h, hash(operation.argument(n).type()));
+	for (size_t n = 0; n < operation.nresults(); n++)
+		h = hash_combine(h, hash(operation.result(n).type()));
+
+	/*
+		Constants of the same type differ only in their values. Hash the
+		values of the frequent ones, such that they are spread over buckets.
+	*/
+	/*
+		The string form of a bitconstant covers all its bits, whereas to_uint()
+		throws for values that do not fit into 64 bits.
+	*/
+	if (auto op = dynamic_cast<const jive::bitconstant_op*>(&operation))
+		return hash_combine(h, std::hash<std::string>()(op->value().str()));
+
+	if (auto op = dynamic_cast<const jive::ctlconstant_op*>(&operation))
+		return hash_combine(h, op->value().alternative());
+
+	if (auto op = dynamic_cast<const fpconstant_op*>(&operation))
+		return hash_combine(h, llvm::hash_value(op->constant()));
+
+	return h;
+}
+
+}
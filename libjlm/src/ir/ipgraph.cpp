@@ -6,51 +6,12 @@
 #include <jlm/ir/ipgraph.hpp>
 #include <jlm/ir/cfg.hpp>
 #include <jlm/ir/tac.hpp>
+#include <jlm/util/scc.hpp>
 
 #include <jive/common.h>
 
 #include <stdio.h>
 
-#include <algorithm>
-
-/* Tarjan's SCC algorithm */
-
-static void
-strongconnect(
-	const jlm::ipgraph_node * node,
-	std::unordered_map<const jlm::ipgraph_node*, std::pair<size_t,size_t>> & map,
-	std::vector<const jlm::ipgraph_node*> & node_stack,
-	size_t & index,
-	std::vector<std::unordered_set<const jlm::ipgraph_node*>> & sccs)
-{
-	map.emplace(node, std::make_pair(index, index));
-	node_stack.push_back(node);
-	index++;
-
-	for (auto callee : *node) {
-		if (map.find(callee) == map.end()) {
-			/* successor has not been visited yet; recurse on it */
-			strongconnect(callee, map, node_stack, index, sccs);
-			map[node].second = std::min(map[node].second, map[callee].second);
-		} else if (std::find(node_stack.begin(), node_stack.end(), callee) != node_stack.end()) {
-			/* successor is in stack and hence in the current SCC */
-			map[node].second = std::min(map[node].second, map[callee].first);
-		}
-	}
-
-	if (map[node].second == map[node].first) {
-		std::unordered_set<const jlm::ipgraph_node*> scc;
-		const jlm::ipgraph_node * w;
-		do {
-			w = node_stack.back();
-			node_stack.pop_back();
-			scc.insert(w);
-		} while (w != node);
-
-		sccs.push_back(scc);
-	}
-}
-
 namespace jlm {
 
 /* ipgraph */
@@ -58,26 +19,39 @@ namespace jlm {
 void
 ipgraph::add_node(std::unique_ptr<ipgraph_node> node)
 {
+	JLM_DEBUG_ASSERT(&node->clg() == this);
+
+	node->index_ = nodes_.size();
 	nodes_.push_back(std::move(node));
 }
 
 std::vector<std::unordered_set<const ipgraph_node*>>
 ipgraph::find_sccs() const
 {
+	auto successors = [&](size_t id, std::vector<size_t> & ids)
+	{
+		for (auto callee : *nodes_[id]) {
+			JLM_DEBUG_ASSERT(&callee->clg() == this);
+			ids.push_back(callee->index());
+		}
+	};
+
 	std::vector<std::unordered_set<const ipgraph_node*>> sccs;
+	auto emit = [&](sccfinder::const_iterator first, sccfinder::const_iterator last)
+	{
+		std::unordered_set<const ipgraph_node*> scc;
+		for (auto it = first; it != last; it++)
+			scc.insert(nodes_[*it].get());
 
-	std::unordered_map<const ipgraph_node*, std::pair<size_t,size_t>> map;
-	std::vector<const ipgraph_node*> node_stack;
-	size_t index = 0;
+		sccs.push_back(std::move(scc));
+	};
 
-	for (auto & node : *this) {
-		if (map.find(&node) == map.end())
-			strongconnect(&node, map, node_stack, index, sccs);
-	}
+	sccfinder finder;
+	for (size_t n = 0; n < nodes_.size(); n++)
+		finder.find(n, nodes_.size(), successors, emit);
 
 	return sccs;
 }
-
 const ipgraph_node *
 ipgraph::find(const std::string & name) const noexcept
 {
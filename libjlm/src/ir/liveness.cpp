@@ -0,0 +1,82 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/liveness.hpp>
+#include <jlm/ir/operators/operators.hpp>
+
+namespace jlm {
+
+liveness::liveness(const jlm::cfg & cfg)
+: cfg_(cfg)
+, niterations_(0)
+{
+	std::vector<variableset> reads(cfg.nindices(), variableset(index_));
+	std::vector<variableset> writes(cfg.nindices(), variableset(index_));
+	std::vector<variableset> phireads(cfg.nindices(), variableset(index_));
+
+	for (const auto & argument : cfg.entry()->arguments())
+		writes[cfg.entry()->index()].insert(argument);
+
+	for (const auto & result : cfg.exit()->results())
+		reads[cfg.exit()->index()].insert(result);
+
+	for (const auto & bb : cfg) {
+		readwrite(bb.tacs(), reads[bb.index()], writes[bb.index()]);
+
+		for (const auto & tac : bb.tacs()) {
+			if (!is<phi_op>(tac->operation()))
+				break;
+
+			auto phi = static_cast<const phi_op*>(&tac->operation());
+			for (size_t n = 0; n < tac->noperands(); n++)
+				phireads[phi->node(n)->index()].insert(tac->operand(n));
+		}
+	}
+
+	/*
+		The operands of a phi are read at the end of a predecessor. They are
+		therefore live at its beginning if the predecessor does not write them.
+	*/
+	dataflow df(cfg, dataflow::direction::backward, dataflow::meet::unite, index_.size());
+	for (size_t n = 0; n < cfg.nindices(); n++) {
+		auto node = cfg.node(n);
+		if (node == nullptr)
+			continue;
+
+		auto gen = phireads[n];
+		gen -= writes[n];
+		gen |= reads[n];
+		df.gen(node) = gen.bits();
+		df.kill(node) = writes[n].bits();
+	}
+	niterations_ = df.solve();
+
+	in_.reserve(cfg.nindices());
+	out_.reserve(cfg.nindices());
+	for (size_t n = 0; n < cfg.nindices(); n++) {
+		auto node = cfg.node(n);
+		in_.push_back(node ? variableset(index_, df.in(node)) : variableset(index_));
+		out_.push_back(node ? variableset(index_, df.out(node)) : variableset(index_));
+		out_.back() |= phireads[n];
+	}
+}
+
+const variableset &
+liveness::in(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return in_[node->index()];
+}
+
+const variableset &
+liveness::out(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return out_[node->index()];
+}
+
+}
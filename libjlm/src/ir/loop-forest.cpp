@@ -0,0 +1,418 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/cfg-node.hpp>
+#include <jlm/ir/loop-forest.hpp>
+#include <jlm/util/scc.hpp>
+
+#include <algorithm>
+
+namespace jlm {
+
+static bool
+index_order(const cfg_node * n1, const cfg_node * n2) noexcept
+{
+	return n1->index() < n2->index();
+}
+
+loopforest::loopforest(const jlm::cfg & cfg)
+: cfg_(cfg)
+, positions_(cfg.nindices(), none)
+, innermost_(cfg.nindices(), nullptr)
+{
+	if (!find_natural_loops())
+		find_scc_loops();
+
+	annotate();
+}
+
+/*
+	Every loop of a reducible cfg has exactly one header, which dominates the
+	loop, and the loops are the natural loops of the headers. They are found
+	in almost linear time by visiting the nodes in reverse depth-first preorder
+	and collapsing the body of every loop into its header with a union-find
+	structure. If a loop body is entered through another node than its header,
+	the cfg is irreducible and no loops are created.
+*/
+bool
+loopforest::find_natural_loops()
+{
+	auto & cfg = cfg_;
+
+	/* number the reachable nodes in depth-first preorder */
+	std::vector<cfg_node*> vertices;
+	std::vector<size_t> numbers(cfg.nindices(), none);
+	std::vector<size_t> last;
+	std::vector<std::pair<cfg_node*, size_t>> stack({{cfg.entry(), 0}});
+	numbers[cfg.entry()->index()] = 0;
+	vertices.push_back(cfg.entry());
+	last.push_back(0);
+	while (!stack.empty()) {
+		auto node = stack.back().first;
+		auto n = stack.back().second;
+		if (n == node->noutedges()) {
+			last[numbers[node->index()]] = vertices.size()-1;
+			stack.pop_back();
+			continue;
+		}
+
+		stack.back().second++;
+		auto sink = node->outedge(n)->sink();
+		if (numbers[sink->index()] == none) {
+			numbers[sink->index()] = vertices.size();
+			vertices.push_back(sink);
+			last.push_back(0);
+			stack.push_back({sink, 0});
+		}
+	}
+
+	std::vector<size_t> sets(vertices.size());
+	for (size_t n = 0; n < sets.size(); n++)
+		sets[n] = n;
+
+	auto find = [&](size_t n)
+	{
+		while (sets[n] != n) {
+			sets[n] = sets[sets[n]];
+			n = sets[n];
+		}
+		return n;
+	};
+
+	/* The innermost enclosing header of every vertex. */
+	std::vector<size_t> headers(vertices.size(), none);
+	std::vector<bool> isheader(vertices.size(), false);
+	std::vector<size_t> marks(vertices.size(), none);
+	std::vector<size_t> body;
+	std::vector<size_t> worklist;
+	for (size_t w = vertices.size(); w > 0; w--) {
+		auto header = w-1;
+		auto insubtree = [&](size_t n)
+		{
+			return header <= n && n <= last[header];
+		};
+
+		body.clear();
+		auto node = vertices[header];
+		for (auto it = node->begin_inedges(); it != node->end_inedges(); it++) {
+			auto n = numbers[(*it)->source()->index()];
+			if (n == none || !insubtree(n))
+				continue;
+
+			isheader[header] = true;
+			n = find(n);
+			if (n != header && marks[n] != header) {
+				marks[n] = header;
+				body.push_back(n);
+			}
+		}
+
+		worklist = body;
+		while (!worklist.empty()) {
+			auto node = vertices[worklist.back()];
+			worklist.pop_back();
+			for (auto it = node->begin_inedges(); it != node->end_inedges(); it++) {
+				/*
+					The loop is entered through another node than its header. Edges
+					from unreachable nodes enter a loop as well.
+				*/
+				auto n = numbers[(*it)->source()->index()];
+				if (n == none || !insubtree(n))
+					return false;
+
+				n = find(n);
+				if (n != header && marks[n] != header) {
+					marks[n] = header;
+					body.push_back(n);
+					worklist.push_back(n);
+				}
+			}
+		}
+
+		for (const auto & n : body) {
+			headers[n] = header;
+			sets[n] = header;
+		}
+	}
+
+	/* create the loops in preorder of their headers, i.e., parents first */
+	std::vector<cfg_loop*> loops(vertices.size(), nullptr);
+	for (size_t n = 0; n < vertices.size(); n++) {
+		if (!isheader[n])
+			continue;
+
+		auto parent = headers[n] != none ? loops[headers[n]] : nullptr;
+		loops_.push_back(std::unique_ptr<cfg_loop>(new cfg_loop(*this, parent, 0, 0)));
+		loops[n] = loops_.back().get();
+		if (parent)
+			parent->children_.push_back(loops[n]);
+		else
+			roots_.push_back(loops[n]);
+	}
+
+	for (size_t n = 0; n < vertices.size(); n++) {
+		auto loop = isheader[n] ? loops[n] : (headers[n] != none ? loops[headers[n]] : nullptr);
+		innermost_[vertices[n]->index()] = loop;
+		if (loop)
+			loop->end_++;
+	}
+
+	layout(vertices);
+	return true;
+}
+
+/*
+	Assigns the ranges of the loops in preorder of the forest, and sorts the
+	loops accordingly. The range of a loop starts with its own nodes, which are
+	ordered as in \p nodes, and is followed by the ranges of its nested loops.
+	On entry, the end of every loop holds the number of its own nodes.
+*/
+void
+loopforest::layout(const std::vector<cfg_node*> & nodes)
+{
+	for (auto it = loops_.rbegin(); it != loops_.rend(); it++) {
+		if (auto parent = (*it)->parent())
+			parent->end_ += (*it)->end_;
+	}
+
+	size_t offset = 0;
+	for (const auto & root : roots_) {
+		root->begin_ = offset;
+		offset += root->end_;
+	}
+	nodes_.resize(offset);
+
+	/* the begin of every loop temporarily points to the end of its own nodes */
+	std::vector<cfg_loop*> stack(roots_.rbegin(), roots_.rend());
+	while (!stack.empty()) {
+		auto loop = stack.back();
+		stack.pop_back();
+
+		auto begin = loop->begin_;
+		auto size = loop->end_;
+		for (const auto & child : loop->children_)
+			size -= child->end_;
+
+		auto offset = begin + size;
+		for (const auto & child : loop->children_) {
+			child->begin_ = offset;
+			offset += child->end_;
+		}
+
+		loop->begin_ = begin + size;
+		loop->end_ = offset;
+		stack.insert(stack.end(), loop->children_.rbegin(), loop->children_.rend());
+	}
+
+	for (auto it = nodes.rbegin(); it != nodes.rend(); it++) {
+		if (auto loop = innermost_[(*it)->index()]) {
+			nodes_[--loop->begin_] = *it;
+			positions_[(*it)->index()] = loop->begin_;
+		}
+	}
+
+	std::sort(loops_.begin(), loops_.end(),
+		[](const std::unique_ptr<cfg_loop> & l1, const std::unique_ptr<cfg_loop> & l2)
+		{
+			return l1->begin_ < l2->begin_;
+		});
+}
+
+/*
+	The loops of an irreducible cfg are found by repeatedly searching the
+	strongly connected components of the loops, after the edges to their
+	headers are removed. The cost is proportional to the sum of the sizes of
+	all loops.
+*/
+void
+loopforest::find_scc_loops()
+{
+	auto & cfg = cfg_;
+	std::vector<bool> headers(cfg.nindices(), false);
+
+	/*
+		Finds the components among the nodes in [begin, end) of nodes_ and
+		creates a loop for every non-trivial one. The positions of the nodes in
+		the range must be set, and edges to headers are ignored. The nodes of the
+		found loops are moved to the front of the range in the order in which they
+		are found.
+	*/
+	sccfinder finder;
+	std::vector<size_t> ids;
+	std::vector<std::unique_ptr<cfg_loop>> loops;
+	auto find_loops = [&](cfg_loop * parent, size_t begin, size_t end)
+	{
+		auto inrange = [&](size_t id)
+		{
+			return positions_[id] != none && begin <= positions_[id] && positions_[id] < end;
+		};
+
+		auto successors = [&](size_t id, std::vector<size_t> & sinks)
+		{
+			auto node = cfg.node(id);
+			for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
+				auto sink = it->sink()->index();
+				if (inrange(sink) && !headers[sink])
+					sinks.push_back(sink);
+			}
+		};
+
+		std::vector<size_t> offsets;
+		auto emit = [&](sccfinder::const_iterator first, sccfinder::const_iterator last)
+		{
+			auto node = cfg.node(*first);
+			if (std::distance(first, last) == 1 && (headers[*first] || !node->has_selfloop_edge()))
+				return;
+
+			offsets.push_back(ids.size());
+			ids.insert(ids.end(), first, last);
+		};
+
+		ids.clear();
+		finder.clear();
+		for (size_t n = begin; n < end; n++)
+			finder.find(nodes_[n]->index(), cfg.nindices(), successors, emit);
+
+		auto nloops = offsets.size();
+		offsets.push_back(ids.size());
+		for (const auto & id : ids)
+			positions_[id] = none;
+
+		for (size_t n = begin; n < end; n++) {
+			if (positions_[nodes_[n]->index()] != none)
+				ids.push_back(nodes_[n]->index());
+		}
+
+		for (size_t n = 0; n < ids.size(); n++) {
+			nodes_[begin+n] = cfg.node(ids[n]);
+			positions_[ids[n]] = begin+n;
+		}
+
+		for (size_t n = 0; n < nloops; n++) {
+			auto loop = std::unique_ptr<cfg_loop>(
+				new cfg_loop(*this, parent, begin+offsets[n], begin+offsets[n+1]));
+			for (size_t i = loop->begin_; i < loop->end_; i++)
+				innermost_[nodes_[i]->index()] = loop.get();
+
+			if (parent)
+				parent->children_.push_back(loop.get());
+			else
+				roots_.push_back(loop.get());
+			loops.push_back(std::move(loop));
+		}
+	};
+
+	/* the outermost loops are the components of all reachable nodes */
+	std::vector<cfg_node*> stack({cfg.entry()});
+	positions_[cfg.entry()->index()] = 0;
+	while (!stack.empty()) {
+		auto node = stack.back();
+		stack.pop_back();
+		nodes_.push_back(node);
+		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
+			if (positions_[it->sink()->index()] == none) {
+				positions_[it->sink()->index()] = 0;
+				stack.push_back(it->sink());
+			}
+		}
+	}
+
+	for (size_t n = 0; n < nodes_.size(); n++)
+		positions_[nodes_[n]->index()] = n;
+
+	find_loops(nullptr, 0, nodes_.size());
+
+	/*
+		Refine the loops in preorder. The headers of a loop are determined before
+		its nested loops are found, such that the range of the loop only contains
+		its own nodes and the nodes of its nested loops.
+	*/
+	std::reverse(loops.begin(), loops.end());
+	while (!loops.empty()) {
+		auto loop = loops.back().get();
+		loops_.push_back(std::move(loops.back()));
+		loops.pop_back();
+
+		for (auto it = loop->begin_nodes(); it != loop->end_nodes(); it++) {
+			for (auto e = (*it)->begin_inedges(); e != (*it)->end_inedges(); e++) {
+				if (!loop->contains((*e)->source())) {
+					headers[(*it)->index()] = true;
+					break;
+				}
+			}
+		}
+
+		auto nloops = loops.size();
+		find_loops(loop, loop->begin_, loop->end_);
+		std::reverse(loops.begin()+nloops, loops.end());
+	}
+
+	/* the nodes that are not part of any loop follow the outermost loops */
+	auto nnodes = roots_.empty() ? 0 : roots_.back()->end_;
+	for (size_t n = nnodes; n < nodes_.size(); n++)
+		positions_[nodes_[n]->index()] = none;
+	nodes_.resize(nnodes);
+}
+
+/*
+	Determines the headers, latches, and exits of all loops from the edges of
+	the cfg. An edge enters at most the innermost loop of its sink, since a
+	header is never part of a nested loop, but it can leave several loops.
+*/
+void
+loopforest::annotate()
+{
+	std::vector<bool> headers(cfg_.nindices(), false);
+	auto annotate = [&](const cfg_node * node)
+	{
+		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
+			auto sink = it->sink();
+			auto loop = innermost(sink);
+			if (loop && !loop->contains(node) && !headers[sink->index()]) {
+				headers[sink->index()] = true;
+				loop->headers_.push_back(sink);
+			}
+
+			for (loop = innermost(node); loop && !loop->contains(sink); loop = loop->parent())
+				loop->exits_.push_back(it.edge());
+		}
+	};
+
+	annotate(cfg_.entry());
+	annotate(cfg_.exit());
+	for (const auto & node : cfg_)
+		annotate(&node);
+
+	for (const auto & loop : loops_) {
+		for (const auto & header : loop->headers_) {
+			for (auto it = header->begin_inedges(); it != header->end_inedges(); it++) {
+				if (loop->contains((*it)->source()))
+					loop->latches_.push_back((*it)->source());
+			}
+		}
+
+		std::sort(loop->headers_.begin(), loop->headers_.end(), index_order);
+		std::sort(loop->latches_.begin(), loop->latches_.end(), index_order);
+		auto last = std::unique(loop->latches_.begin(), loop->latches_.end());
+		loop->latches_.erase(last, loop->latches_.end());
+	}
+}
+
+size_t
+loopforest::position(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return node->index() < positions_.size() ? positions_[node->index()] : none;
+}
+
+cfg_loop *
+loopforest::innermost(const cfg_node * node) const noexcept
+{
+	JLM_DEBUG_ASSERT(&node->cfg() == &cfg_);
+	return node->index() < innermost_.size() ? innermost_[node->index()] : nullptr;
+}
+
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/hash.hpp>
+#include <jlm/ir/operation-pool.hpp>
+
+#include <jive/rvsdg/operation.h>
+
+namespace jlm {
+
+operation_pool::~operation_pool()
+{}
+
+const jive::operation *
+operation_pool::intern(const jive::simple_op & operation)
+{
+	auto key = hash(operation);
+	auto range = operations_.equal_range(key);
+	for (auto it = range.first; it != range.second; it++) {
+		if (it->second.get() == &operation || *it->second == operation)
+			return it->second.get();
+	}
+
+	auto it = operations_.emplace(key, operation.copy());
+	return it->second.get();
+}
+
+}
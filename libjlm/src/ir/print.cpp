@@ -7,6 +7,7 @@
 #include <jlm/ir/basic-block.hpp>
 #include <jlm/ir/cfg.hpp>
 #include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/loop-forest.hpp>
 #include <jlm/ir/operators/operators.hpp>
 #include <jlm/ir/print.hpp>
 #include <jlm/ir/tac.hpp>
@@ -344,6 +345,36 @@ emit_node(const jlm::cfg_node & node)
 	return emit_header(node) + "\\n" + body;
 }
 
+static inline std::string
+emit_node_dot(const jlm::cfg_node & node)
+{
+	return strfmt((intptr_t)&node, "[shape = box, label = \"", emit_node(node), "\"];\n");
+}
+
+/*
+	Emits every loop as a cluster that contains the nodes of the loop and
+	the clusters of its nested loops.
+*/
+static std::string
+emit_loop_dot(
+	const cfg_loop & loop,
+	const std::unordered_map<const cfg_loop*, std::vector<const cfg_node*>> & nodes)
+{
+	std::string dot = strfmt("subgraph cluster_", (intptr_t)&loop, " {\n");
+	dot += strfmt("label = \"loop ", loop.depth(), "\";\n");
+
+	auto it = nodes.find(&loop);
+	if (it != nodes.end()) {
+		for (const auto & node : it->second)
+			dot += emit_node_dot(*node);
+	}
+
+	for (size_t n = 0; n < loop.nchildren(); n++)
+		dot += emit_loop_dot(*loop.child(n), nodes);
+
+	return dot + "}\n";
+}
+
 std::string
 to_dot(const jlm::cfg & cfg)
 {
@@ -362,9 +393,20 @@ to_dot(const jlm::cfg & cfg)
 	dot += strfmt("{ rank = sink; ", (intptr_t)exit, "[shape=box, label = \"",
 		emit_node(*exit), "\"]; }\n");
 
+	/* emit basic blocks grouped by their innermost loop */
+	loopforest forest(cfg);
+	std::unordered_map<const cfg_loop*, std::vector<const cfg_node*>> nodes;
+	for (const auto & node : cfg) {
+		if (auto loop = forest.innermost(&node))
+			nodes[loop].push_back(&node);
+		else
+			dot += strfmt("{", emit_node_dot(node), "}\n");
+	}
+
+	for (size_t n = 0; n < forest.nroots(); n++)
+		dot += emit_loop_dot(*forest.root(n), nodes);
+
 	for (const auto & node : cfg) {
-		dot += strfmt("{", (intptr_t)&node);
-		dot += strfmt("[shape = box, label = \"", emit_node(node), "\"]; }\n");
 		for (auto it = node.begin_outedges(); it != node.end_outedges(); it++) {
 			dot += strfmt((intptr_t)it->source(), " -> ", (intptr_t)it->sink());
 			dot += strfmt("[label = \"", it->index(), "\"];\n");
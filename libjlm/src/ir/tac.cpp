@@ -3,10 +3,12 @@
  * See COPYING for terms of redistribution.
  */
 
+#include <jlm/ir/operation-pool.hpp>
 #include <jlm/ir/tac.hpp>
 
 #include <jive/rvsdg/type.h>
 
+#include <algorithm>
 #include <sstream>
 
 namespace jlm {
@@ -20,16 +22,28 @@ tacvariable::~tacvariable()
 
 taclist::~taclist()
 {
-	for (const auto & tac : tacs_)
+	clear();
+}
+
+void
+taclist::clear() noexcept
+{
+	auto tac = first_;
+	while (tac) {
+		auto next = tac->next_;
 		delete tac;
+		tac = next;
+	}
+
+	reset();
 }
 
 /* tac */
 
-static void
+template <class T> static void
 check_operands(
 	const jive::simple_op & operation,
-	const std::vector<const variable*> & operands)
+	const T & operands)
 {
 	if (operands.size() != operation.narguments())
 		throw jlm::error("invalid number of operands.");
@@ -40,10 +54,10 @@ check_operands(
 	}
 }
 
-static void
+template <class T> static void
 check_results(
 	const jive::simple_op & operation,
-	const std::vector<const variable*> & results)
+	const T & results)
 {
 	if (results.size() != operation.nresults())
 		throw jlm::error("invalid number of variables.");
@@ -58,12 +72,57 @@ tac::tac(
 	const jive::simple_op & operation,
 	const std::vector<const variable *> & operands,
 	const std::vector<const variable *> & results)
-	: results_(results)
-	, operands_(operands)
-	, operation_(std::move(operation.copy()))
+	: tac(operation, operandvector(operands.begin(), operands.end()),
+		resultvector(results.begin(), results.end()))
+{}
+
+tac::tac(
+	const jive::simple_op & operation,
+	std::initializer_list<const variable *> operands,
+	std::initializer_list<const variable *> results)
+	: tac(operation, operandvector(operands), resultvector(results))
+{}
+
+tac::tac(
+	const jive::simple_op & operation,
+	operandvector operands,
+	resultvector results)
+	: prev_(nullptr)
+	, next_(nullptr)
+	, results_(std::move(results))
+	, operands_(std::move(operands))
+	, operation_(nullptr)
+	, pool_(nullptr)
 {
-	check_operands(operation, operands);
-	check_results(operation, results);
+	check_operands(operation, operands_);
+	check_results(operation, results_);
+	operation_ = operation.copy().release();
+	add_users();
+}
+
+tac::tac(
+	operation_pool & pool,
+	const jive::simple_op & operation,
+	operandvector operands,
+	resultvector results)
+	: prev_(nullptr)
+	, next_(nullptr)
+	, results_(std::move(results))
+	, operands_(std::move(operands))
+	, operation_(nullptr)
+	, pool_(&pool)
+{
+	check_operands(operation, operands_);
+	check_results(operation, results_);
+	operation_ = pool.intern(operation);
+	add_users();
+}
+
+tac::~tac() noexcept
+{
+	remove_users();
+	if (!pool_)
+		delete operation_;
 }
 
 void
@@ -71,13 +130,84 @@ tac::replace(
 	const jive::simple_op & operation,
 	const std::vector<const variable*> & operands,
 	const std::vector<const variable*> & results)
+{
+	replace(operation, operandvector(operands.begin(), operands.end()),
+		resultvector(results.begin(), results.end()));
+}
+
+void
+tac::replace(
+	const jive::simple_op & operation,
+	std::initializer_list<const variable*> operands,
+	std::initializer_list<const variable*> results)
+{
+	replace(operation, operandvector(operands), resultvector(results));
+}
+
+void
+tac::replace(
+	const jive::simple_op & operation,
+	operandvector operands,
+	resultvector results)
 {
 	check_operands(operation, operands);
 	check_results(operation, results);
 
-	results_ = results;
-	operands_ = operands;
-	operation_ = std::move(operation.copy());
+	auto op = pool_ ? pool_->intern(operation) : operation.copy().release();
+	if (!pool_)
+		delete operation_;
+	operation_ = op;
+
+	remove_users();
+	results_ = std::move(results);
+	operands_ = std::move(operands);
+	add_users();
+}
+
+void
+tac::intern(operation_pool & pool)
+{
+	if (pool_) {
+		JLM_DEBUG_ASSERT(pool_ == &pool);
+		return;
+	}
+
+	auto op = pool.intern(operation());
+	delete operation_;
+	operation_ = op;
+	pool_ = &pool;
+}
+
+void
+tac::add_users()
+{
+	JLM_DEBUG_ASSERT(uses_.empty());
+
+	for (auto it = operands_.begin(); it != operands_.end(); it++) {
+		if (std::find(operands_.begin(), it, *it) == it)
+			uses_.push_back({this, nullptr, nullptr});
+	}
+
+	/*
+		The entries are only linked once all of them exist, as appending to
+		uses_ might reallocate them.
+	*/
+	size_t n = 0;
+	for (auto it = operands_.begin(); it != operands_.end(); it++) {
+		if (std::find(operands_.begin(), it, *it) == it)
+			(*it)->users_.append(&uses_[n++]);
+	}
+}
+
+void
+tac::remove_users() noexcept
+{
+	size_t n = 0;
+	for (auto it = operands_.begin(); it != operands_.end(); it++) {
+		if (std::find(operands_.begin(), it, *it) == it)
+			(*it)->users_.remove(&uses_[n++]);
+	}
+	uses_.clear();
 }
 
 }
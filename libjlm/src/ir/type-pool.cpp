@@ -0,0 +1,30 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/hash.hpp>
+#include <jlm/ir/type-pool.hpp>
+
+#include <jive/rvsdg/type.h>
+
+namespace jlm {
+
+type_pool::~type_pool()
+{}
+
+const jive::type *
+type_pool::intern(const jive::type & type)
+{
+	auto key = hash(type);
+	auto range = types_.equal_range(key);
+	for (auto it = range.first; it != range.second; it++) {
+		if (*it->second == type)
+			return it->second.get();
+	}
+
+	auto it = types_.emplace(key, type.copy());
+	return it->second.get();
+}
+
+}
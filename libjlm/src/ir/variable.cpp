@@ -3,6 +3,7 @@
  * See COPYING for terms of redistribution.
  */
 
+#include <jlm/ir/tac.hpp>
 #include <jlm/ir/variable.hpp>
 
 namespace jlm {
@@ -10,7 +11,9 @@ namespace jlm {
 /* variable */
 
 variable::~variable() noexcept
-{}
+{
+	JLM_DEBUG_ASSERT(nusers() == 0);
+}
 
 std::string
 variable::debug_string() const
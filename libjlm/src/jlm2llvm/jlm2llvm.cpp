@@ -18,6 +18,8 @@
 #include <jlm/jlm2llvm/jlm2llvm.hpp>
 #include <jlm/jlm2llvm/type.hpp>
 
+#include <jlm/util/trace.hpp>
+
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
@@ -258,6 +260,7 @@ convert_function(const jlm::function_node & node, context & ctx)
 	if (!node.cfg())
 		return;
 
+	trace_scope scope("function", node.name());
 	auto & im = ctx.module();
 	auto f = llvm::cast<llvm::Function>(ctx.value(im.variable(&node)));
 	convert_cfg(*node.cfg(), *f, ctx);
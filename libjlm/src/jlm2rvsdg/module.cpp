@@ -17,8 +17,10 @@
 #include <jlm/ir/ssa.hpp>
 #include <jlm/ir/tac.hpp>
 
+#include <jlm/util/parallel.hpp>
 #include <jlm/util/stats.hpp>
 #include <jlm/util/time.hpp>
+#include <jlm/util/trace.hpp>
 
 #include <jive/arch/address.h>
 #include <jive/arch/addresstype.h>
@@ -36,6 +38,7 @@
 #include <jive/rvsdg/theta.h>
 #include <jive/rvsdg/type.h>
 
+#include <algorithm>
 #include <cmath>
 #include <stack>
 
@@ -66,7 +69,8 @@ public:
 	{}
 
 	cfrstat(const std::string & filename, const std::string & fctname)
-	: nnodes_(0)
+	: stat(statid::cfr)
+	, nnodes_(0)
 	, fctname_(fctname)
 	, filename_(filename)
 	{}
@@ -84,10 +88,13 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("CFRTIME ", filename_, " ", fctname_, " ", nnodes_, " ", timer_.ns());
+		return {
+		  {"file", filename_}, {"function", fctname_}
+		, {"nnodes", nnodes_}, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -104,7 +111,8 @@ public:
 	{}
 
 	aggregation_stat(const std::string & filename, const std::string & fctname)
-	: nnodes_(0)
+	: stat(statid::aggregation)
+	, nnodes_(0)
 	, fctname_(fctname)
 	, filename_(filename)
 	{}
@@ -122,10 +130,13 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("AGGREGATIONTIME ", filename_, " ", fctname_, " ", nnodes_, " ", timer_.ns());
+		return {
+		  {"file", filename_}, {"function", fctname_}
+		, {"nnodes", nnodes_}, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -142,7 +153,8 @@ public:
 	{}
 
 	annotation_stat(const std::string & filename, const std::string & fctname)
-	: ntacs_(0)
+	: stat(statid::annotation)
+	, ntacs_(0)
 	, fctname_(fctname)
 	, filename_(filename)
 	{}
@@ -160,10 +172,13 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("ANNOTATIONTIME ", filename_, " ", fctname_, " ", ntacs_, " ", timer_.ns());
+		return {
+		  {"file", filename_}, {"function", fctname_}
+		, {"ntacs", ntacs_}, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -180,8 +195,13 @@ public:
 	{}
 
 	rvsdg_construction_stat(const jlm::filepath & filename)
-	: ntacs_(0)
+	: stat(statid::rvsdg_construction)
+	, ntacs_(0)
 	, nnodes_(0)
+	, nvariables_(0)
+	, arena_bytes_(0)
+	, noperations_(0)
+	, ntypes_(0)
 	, filename_(filename)
 	{}
 
@@ -189,6 +209,10 @@ public:
 	start(const ipgraph_module & im) noexcept
 	{
 		ntacs_ = jlm::ntacs(im);
+		nvariables_ = im.arena().nobjects();
+		arena_bytes_ = im.arena().nbytes();
+		noperations_ = im.operations().noperations();
+		ntypes_ = im.types().ntypes();
 		timer_.start();
 	}
 
@@ -199,16 +223,25 @@ public:
 		nnodes_ = jive::nnodes(graph.root());
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("RVSDGCONSTRUCTION ", filename_.to_str(), " ",
-			ntacs_, " ", nnodes_, " ", timer_.ns());
+		return {
+		  {"file", filename_.to_str()}
+		, {"ntacs", ntacs_}, {"nnodes", nnodes_}
+		, {"nvariables", nvariables_}, {"arena_bytes", arena_bytes_}
+		, {"noperations", noperations_}, {"ntypes", ntypes_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
 	size_t ntacs_;
 	size_t nnodes_;
+	size_t nvariables_;
+	size_t arena_bytes_;
+	size_t noperations_;
+	size_t ntypes_;
 	jlm::timer timer_;
 	jlm::filepath filename_;
 };
@@ -603,50 +636,157 @@ convert_node(
 	return map[typeid(node)](node, dm, function, lb, svmap);
 }
 
-static jive::output *
-convert_cfg(
-	const jlm::function_node & function,
-	jive::region * region,
-	scoped_vmap & svmap,
-	const stats_descriptor & sd)
+/*
+	The aggregation tree and demand annotation of a function, together with
+	the stats of the passes that computed them.
+*/
+struct aggregated_cfg {
+	aggregated_cfg(const std::string & fctname)
+	: cfr(source_filename, fctname)
+	, aggregation(source_filename, fctname)
+	, annotation(source_filename, fctname)
+	{}
+
+	std::unique_ptr<aggnode> root;
+	demandmap dm;
+	cfrstat cfr;
+	aggregation_stat aggregation;
+	annotation_stat annotation;
+};
+
+typedef std::unordered_map<
+	const function_node*,
+	std::unique_ptr<aggregated_cfg>
+> aggregated_cfgs;
+
+/*
+	Destructs the SSA form of a cfg and removes superfluous nodes. The
+	destruction creates tacs that use the variables of the module, and can
+	therefore not be performed for several cfgs concurrently.
+*/
+static void
+prepare_cfg(jlm::cfg & cfg)
 {
-	auto cfg = function.cfg();
+	destruct_ssa(cfg);
+	straighten(cfg);
+	purge(cfg);
+}
 
-	destruct_ssa(*cfg);
-	straighten(*cfg);
-	purge(*cfg);
+/*
+	Restructures, aggregates, and annotates the cfg of a function. The passes
+	only modify the cfg of the function, such that they can be performed for
+	several functions of a module concurrently.
+*/
+static std::unique_ptr<aggregated_cfg>
+aggregate_cfg(const jlm::function_node & function)
+{
+	auto cfg = function.cfg();
+	auto ac = std::make_unique<aggregated_cfg>(function.name());
 
 	{
-		cfrstat stat(source_filename, function.name());
-		stat.start(*cfg);
+		trace_scope scope("pass", "cfr");
+		ac->cfr.start(*cfg);
 		restructure(cfg);
-		stat.end();
-		if (sd.print_cfr_time)
-			sd.print_stat(stat);
+		ac->cfr.end();
 	}
 
-	std::unique_ptr<aggnode> root;
 	{
-		aggregation_stat stat(source_filename, function.name());
-		stat.start(*cfg);
-		root = aggregate(*cfg);
-		stat.end();
-		if (sd.print_aggregation_time)
-			sd.print_stat(stat);
+		trace_scope scope("pass", "aggregation");
+		ac->aggregation.start(*cfg);
+		ac->root = aggregate(*cfg);
+		ac->aggregation.end();
 	}
 
-	demandmap dm;
 	{
-		annotation_stat stat(source_filename, function.name());
-		stat.start(*root);
-		dm = annotate(*root);
-		stat.end();
-		if (sd.print_annotation_time)
-			sd.print_stat(stat);
+		trace_scope scope("pass", "annotation");
+		ac->annotation.start(*ac->root);
+		ac->dm = annotate(*ac->root);
+		ac->annotation.end();
+	}
+
+	return ac;
+}
+
+static void
+print_stats(const aggregated_cfg & ac, const stats_descriptor & sd)
+{
+	if (sd.is_enabled(statid::cfr))
+		sd.print_stat(ac.cfr);
+
+	if (sd.is_enabled(statid::aggregation))
+		sd.print_stat(ac.aggregation);
+
+	if (sd.is_enabled(statid::annotation))
+		sd.print_stat(ac.annotation);
+}
+
+/*
+	Aggregates the cfgs of all functions of a module on up to \p nthreads
+	threads. The largest cfgs are handed out first, and the stats are printed
+	in the order of the functions in the ipgraph.
+*/
+static aggregated_cfgs
+aggregate_cfgs(const ipgraph_module & im, const stats_descriptor & sd, size_t nthreads)
+{
+	std::vector<const function_node*> functions;
+	for (const auto & node : im.ipgraph()) {
+		auto function = dynamic_cast<const function_node*>(&node);
+		if (function && function->cfg()) {
+			trace_scope scope("function", function->name());
+			prepare_cfg(*function->cfg());
+			functions.push_back(function);
+		}
+	}
+
+	std::vector<size_t> order(functions.size());
+	for (size_t n = 0; n < order.size(); n++)
+		order[n] = n;
+
+	std::stable_sort(order.begin(), order.end(), [&](size_t n1, size_t n2)
+	{
+		return functions[n1]->cfg()->nnodes() > functions[n2]->cfg()->nnodes();
+	});
+
+	std::vector<std::unique_ptr<aggregated_cfg>> acs(functions.size());
+	parallel_for(order.size(), nthreads, [&](size_t n)
+	{
+		auto function = functions[order[n]];
+		trace_scope scope("function", function->name());
+		acs[order[n]] = aggregate_cfg(*function);
+	});
+
+	aggregated_cfgs acfgs;
+	for (size_t n = 0; n < functions.size(); n++) {
+		print_stats(*acs[n], sd);
+		acfgs[functions[n]] = std::move(acs[n]);
+	}
+
+	return acfgs;
+}
+
+static jive::output *
+convert_cfg(
+	const jlm::function_node & function,
+	jive::region * region,
+	scoped_vmap & svmap,
+	aggregated_cfgs & acfgs,
+	const stats_descriptor & sd)
+{
+	trace_scope scope("function", function.name());
+
+	std::unique_ptr<aggregated_cfg> ac;
+	auto it = acfgs.find(&function);
+	if (it != acfgs.end()) {
+		ac = std::move(it->second);
+		acfgs.erase(it);
+	} else {
+		prepare_cfg(*function.cfg());
+		ac = aggregate_cfg(function);
+		print_stats(*ac, sd);
 	}
 
 	lambda_builder lb;
-	auto lambda = convert_node(*root, dm, function, lb, svmap);
+	auto lambda = convert_node(*ac->root, ac->dm, function, lb, svmap);
 	return lambda->output(0);
 }
 
@@ -655,6 +795,7 @@ construct_lambda(
 	const ipgraph_node * node,
 	jive::region * region,
 	scoped_vmap & svmap,
+	aggregated_cfgs & acfgs,
 	const stats_descriptor & sd)
 {
 	JLM_DEBUG_ASSERT(dynamic_cast<const function_node*>(node));
@@ -665,7 +806,7 @@ construct_lambda(
 		return region->graph()->add_import(port);
 	}
 
-	return convert_cfg(function, region, svmap, sd);
+	return convert_cfg(function, region, svmap, acfgs, sd);
 }
 
 static jive::output *
@@ -683,6 +824,7 @@ convert_data_node(
 	const jlm::ipgraph_node * node,
 	jive::region * region,
 	scoped_vmap & svmap,
+	aggregated_cfgs&,
 	const stats_descriptor&)
 {
 	JLM_DEBUG_ASSERT(dynamic_cast<const data_node*>(node));
@@ -721,6 +863,7 @@ handle_scc(
 	const std::unordered_set<const jlm::ipgraph_node*> & scc,
 	jive::graph * graph,
 	scoped_vmap & svmap,
+	aggregated_cfgs & acfgs,
 	const stats_descriptor & sd)
 {
 	auto & m = svmap.module();
@@ -731,6 +874,7 @@ handle_scc(
 		  const ipgraph_node*
 		, jive::region*
 		, scoped_vmap&
+		, aggregated_cfgs&
 		, const stats_descriptor&)>
 	> map({
 	  {typeid(data_node), convert_data_node}
@@ -740,7 +884,7 @@ handle_scc(
 	if (scc.size() == 1 && !(*scc.begin())->is_selfrecursive()) {
 		auto & node = *scc.begin();
 		JLM_DEBUG_ASSERT(map.find(typeid(*node)) != map.end());
-		auto output = map[typeid(*node)](node, graph->root(), svmap, sd);
+		auto output = map[typeid(*node)](node, graph->root(), svmap, acfgs, sd);
 
 		auto v = m.variable(node);
 		JLM_DEBUG_ASSERT(v);
@@ -778,7 +922,7 @@ handle_scc(
 
 		/* convert SCC nodes */
 		for (const auto & node : scc) {
-			auto output = map[typeid(*node)](node, pb.region(), svmap, sd);
+			auto output = map[typeid(*node)](node, pb.region(), svmap, acfgs, sd);
 			recvars[m.variable(node)]->set_value(output);
 		}
 
@@ -797,7 +941,7 @@ handle_scc(
 }
 
 static std::unique_ptr<rvsdg_module>
-convert_module(const ipgraph_module & im, const stats_descriptor & sd)
+convert_module(const ipgraph_module & im, const stats_descriptor & sd, size_t nthreads)
 {
 	auto rm = rvsdg_module::create(im.source_filename(), im.target_triple(), im.data_layout());
 	auto graph = rm->graph();
@@ -810,26 +954,37 @@ convert_module(const ipgraph_module & im, const stats_descriptor & sd)
 
 	scoped_vmap svmap(im, graph->root());
 
+	/* aggregate the cfgs ahead of the conversion, otherwise on demand */
+	aggregated_cfgs acfgs;
+	if (nthreads > 1)
+		acfgs = aggregate_cfgs(im, sd, nthreads);
+
 	/* convert ipgraph nodes */
 	auto sccs = im.ipgraph().find_sccs();
 	for (const auto & scc : sccs)
-		handle_scc(scc, graph, svmap, sd);
+		handle_scc(scc, graph, svmap, acfgs, sd);
 
 	return rm;
 }
 
 std::unique_ptr<rvsdg_module>
 construct_rvsdg(const ipgraph_module & im, const stats_descriptor & sd)
+{
+	return construct_rvsdg(im, sd, 1);
+}
+
+std::unique_ptr<rvsdg_module>
+construct_rvsdg(const ipgraph_module & im, const stats_descriptor & sd, size_t nthreads)
 {
 	source_filename = im.source_filename().to_str();
 
 	rvsdg_construction_stat stat(im.source_filename());
 
 	stat.start(im);
-	auto rm = convert_module(im, sd);
+	auto rm = convert_module(im, sd, nthreads);
 	stat.end(*rm->graph());
 
-	if (sd.print_rvsdg_construction)
+	if (sd.is_enabled(statid::rvsdg_construction))
 		sd.print_stat(stat);
 
 	return rm;
@@ -8,6 +8,7 @@
 #include <jlm/ir/cfg-structure.hpp>
 #include <jlm/ir/cfg-node.hpp>
 #include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/loop-forest.hpp>
 #include <jlm/ir/operators/operators.hpp>
 
 #include <jive/rvsdg/control.h>
@@ -15,28 +16,16 @@
 #include <algorithm>
 #include <cmath>
 #include <deque>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace jlm {
 
 struct scc_structure {
-	typedef std::unordered_set<jlm::cfg_node*>::const_iterator const_node_iterator;
-	typedef std::unordered_set<jlm::cfg_edge*>::const_iterator const_edge_iterator;
-
-	inline
-	scc_structure(
-		const std::unordered_set<jlm::cfg_node*> & enodes,
-		const std::unordered_set<jlm::cfg_node*> & xnodes,
-		const std::unordered_set<jlm::cfg_edge*> & eedges,
-		const std::unordered_set<jlm::cfg_edge*> & redges,
-		const std::unordered_set<jlm::cfg_edge*> & xedges)
-	: enodes_(enodes)
-	, xnodes_(xnodes)
-	, eedges_(eedges)
-	, redges_(redges)
-	, xedges_(xedges)
-	{}
+	typedef std::vector<jlm::cfg_node*>::const_iterator const_node_iterator;
+	typedef std::vector<jlm::cfg_edge*>::const_iterator const_edge_iterator;
 
 	inline size_t
 	nenodes() const noexcept
@@ -128,18 +117,19 @@ struct scc_structure {
 		return xedges_.end();
 	}
 
-	std::unordered_set<jlm::cfg_node*> enodes_;
-	std::unordered_set<jlm::cfg_node*> xnodes_;
-	std::unordered_set<jlm::cfg_edge*> eedges_;
-	std::unordered_set<jlm::cfg_edge*> redges_;
-	std::unordered_set<jlm::cfg_edge*> xedges_;
+	std::vector<jlm::cfg_node*> enodes_;
+	std::vector<jlm::cfg_node*> xnodes_;
+	std::vector<jlm::cfg_edge*> eedges_;
+	std::vector<jlm::cfg_edge*> redges_;
+	std::vector<jlm::cfg_edge*> xedges_;
 };
 
 static inline bool
 is_tcloop(const scc_structure & s)
 {
 	return s.nenodes() == 1 && s.nredges() == 1 && s.nxedges() == 1
-			&& (*s.begin_redges())->source() == (*s.begin_xedges())->source();
+			&& (*s.begin_redges())->source() == (*s.begin_xedges())->source()
+			&& (*s.begin_xedges())->source()->noutedges() == 2;
 }
 
 struct tcloop {
@@ -196,127 +186,76 @@ reinsert_tcloop(const tcloop & l)
 	cfg.remove_node(l.replacement);
 }
 
+/*
+	The loops of the forest are restructured from the outside in. The
+	restructuring of a loop only diverts and splits its entry, exit, and
+	repetition edges, and only adds nodes that are not part of any loop. The
+	nodes, headers, and exit edges of the nested loops therefore remain valid,
+	and only the edges that enter a loop need to be determined anew.
+*/
 static scc_structure
-find_scc_structure(const std::unordered_set<jlm::cfg_node*> & scc)
+find_scc_structure(const cfg_loop & loop)
 {
-	std::unordered_set<jlm::cfg_edge*> eedges;
-	std::unordered_set<jlm::cfg_edge*> redges;
-	std::unordered_set<jlm::cfg_edge*> xedges;
-	std::unordered_set<jlm::cfg_node*> enodes;
-	std::unordered_set<jlm::cfg_node*> xnodes;
-
-	for (auto node : scc) {
-		for (auto it = node->begin_inedges(); it != node->end_inedges(); it++) {
-			if (scc.find((*it)->source()) == scc.end()) {
-				eedges.insert(*it);
-				if (enodes.find(node) == enodes.end())
-					enodes.insert(node);
-			}
-		}
-
-		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-			if (scc.find(it->sink()) == scc.end()) {
-				xedges.insert(it.edge());
-				if (xnodes.find(it->sink()) == xnodes.end())
-					xnodes.insert(it->sink());
-			}
+	scc_structure s;
+	for (size_t n = 0; n < loop.nheaders(); n++) {
+		auto header = loop.header(n);
+		s.enodes_.push_back(header);
+		for (auto it = header->begin_inedges(); it != header->end_inedges(); it++) {
+			if (loop.contains((*it)->source()))
+				s.redges_.push_back(*it);
+			else
+				s.eedges_.push_back(*it);
 		}
 	}
 
-	for (auto node : scc) {
-		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-			if (enodes.find(it->sink()) != enodes.end())
-				redges.insert(it.edge());
-		}
-	}
-
-	return scc_structure(enodes, xnodes, eedges, redges, xedges);
-}
-
-/* Tarjan's SCC algorithm */
-
-static void
-strongconnect(
-	jlm::cfg_node * node,
-	jlm::cfg_node * exit,
-	std::unordered_map<jlm::cfg_node*, std::pair<size_t,size_t>> & map,
-	std::vector<jlm::cfg_node*> & node_stack,
-	size_t & index,
-	std::vector<std::unordered_set<jlm::cfg_node*>> & sccs)
-{
-	map.emplace(node, std::make_pair(index, index));
-	node_stack.push_back(node);
-	index++;
-
-	if (node != exit) {
-		for (auto it = node->begin_outedges(); it != node->end_outedges(); it++) {
-			jlm::cfg_node * successor = it->sink();
-			if (map.find(successor) == map.end()) {
-				/* successor has not been visited yet; recurse on it */
-				strongconnect(successor, exit, map, node_stack, index, sccs);
-				map[node].second = std::min(map[node].second, map[successor].second);
-			} else if (std::find(node_stack.begin(), node_stack.end(), successor) != node_stack.end()) {
-				/* successor is in stack and hence in the current SCC */
-				map[node].second = std::min(map[node].second, map[successor].first);
-			}
-		}
-	}
-
-	if (map[node].second == map[node].first) {
-		std::unordered_set<jlm::cfg_node*> scc;
-		jlm::cfg_node * w;
-		do {
-			w = node_stack.back();
-			node_stack.pop_back();
-			scc.insert(w);
-		} while (w != node);
-
-		if (scc.size() != 1 || (*scc.begin())->has_selfloop_edge())
-			sccs.push_back(scc);
+	std::unordered_set<jlm::cfg_node*> xnodes;
+	for (size_t n = 0; n < loop.nexits(); n++) {
+		auto edge = loop.exit(n);
+		JLM_DEBUG_ASSERT(loop.contains(edge->source()) && !loop.contains(edge->sink()));
+		s.xedges_.push_back(edge);
+		if (xnodes.insert(edge->sink()).second)
+			s.xnodes_.push_back(edge->sink());
 	}
-}
-
-static std::vector<std::unordered_set<cfg_node*>>
-find_sccs(jlm::cfg_node * enter, jlm::cfg_node * exit)
-{
-	std::vector<std::unordered_set<cfg_node*>> sccs;
-
-	std::unordered_map<cfg_node*, std::pair<size_t,size_t>> map;
-	std::vector<cfg_node*> node_stack;
-	size_t index = 0;
-
-	strongconnect(enter, exit, map, node_stack, index, sccs);
 
-	return sccs;
+	return s;
 }
 
+/*
+	The cfgs of a module can be restructured concurrently. The creation of
+	variables and tacs modifies the module and is therefore serialized with
+	the module's mutex.
+
+	The names of the introduced variables are numbered per cfg, i.e., by
+	\p nvariables, such that they do not depend on the order in which the
+	cfgs of a module are restructured.
+*/
 static inline const variable *
-create_pvariable(const jive::ctltype & type, ipgraph_module & im)
+create_pvariable(const jive::ctltype & type, ipgraph_module & im, size_t & nvariables)
 {
-	static size_t c = 0;
-	return im.create_variable(type, strfmt("#p", c++, "#"));
+	std::lock_guard<std::mutex> guard(im.mutex());
+	return im.create_variable(type, "#p", nvariables++, "#");
 }
 
 static inline const variable *
-create_qvariable(const jive::ctltype & type, ipgraph_module & im)
+create_qvariable(const jive::ctltype & type, ipgraph_module & im, size_t & nvariables)
 {
-	static size_t c = 0;
-	return im.create_variable(type, strfmt("#q", c++, "#"));
+	std::lock_guard<std::mutex> guard(im.mutex());
+	return im.create_variable(type, "#q", nvariables++, "#");
 }
 
 static const variable *
-create_tvariable(const jive::ctltype & type, ipgraph_module & im)
+create_tvariable(const jive::ctltype & type, ipgraph_module & im, size_t & nvariables)
 {
-	static size_t c = 0;
-	return im.create_variable(type, strfmt("#t", c++, "#"));
+	std::lock_guard<std::mutex> guard(im.mutex());
+	return im.create_variable(type, "#t", nvariables++, "#");
 }
 
 static inline const variable *
-create_rvariable(ipgraph_module & im)
+create_rvariable(ipgraph_module & im, size_t & nvariables)
 {
-	static size_t c = 0;
 	jive::ctltype type(2);
-	return im.create_variable(type, strfmt("#r", c++, "#"));
+	std::lock_guard<std::mutex> guard(im.mutex());
+	return im.create_variable(type, "#r", nvariables++, "#");
 }
 
 static inline void
@@ -324,6 +263,8 @@ append_branch(basic_block * bb, const variable * operand)
 {
 	JLM_DEBUG_ASSERT(dynamic_cast<const jive::ctltype*>(&operand->type()));
 	auto nalternatives = static_cast<const jive::ctltype*>(&operand->type())->nalternatives();
+
+	std::lock_guard<std::mutex> guard(bb->cfg().module().mutex());
 	bb->append_last(create_branch_tac(nalternatives, operand));
 }
 
@@ -334,7 +275,8 @@ append_constant(basic_block * bb, const variable * result, size_t value)
 	auto nalternatives = static_cast<const jive::ctltype*>(&result->type())->nalternatives();
 
 	jive::ctlconstant_op op(jive::ctlvalue_repr(value, nalternatives));
-	bb->append_last(tac::create(op, {}, {result}));
+	std::lock_guard<std::mutex> guard(bb->cfg().module().mutex());
+	bb->append_last(tac::create(bb->cfg().module().operations(), op, {}, {result}));
 }
 
 static inline void
@@ -405,30 +347,44 @@ restructure_loop_repetition(
 }
 
 static void
-restructure(jlm::cfg_node*, jlm::cfg_node*, std::vector<tcloop>&);
+restructure(
+	jlm::cfg_node*,
+	jlm::cfg_node*,
+	const loopforest&,
+	const cfg_loop*,
+	std::vector<tcloop>&,
+	size_t&);
 
 static void
-restructure_loops(jlm::cfg_node * entry, jlm::cfg_node * exit, std::vector<tcloop> & loops)
+restructure_loops(
+	const loopforest & forest,
+	const cfg_loop * parent,
+	std::vector<tcloop> & loops,
+	size_t & nvariables)
 {
-	if (entry == exit)
-		return;
+	auto nloops = parent ? parent->nchildren() : forest.nroots();
+	for (size_t n = 0; n < nloops; n++) {
+		auto loop = parent ? parent->child(n) : forest.root(n);
+		auto & cfg = loop->header(0)->cfg();
+		auto & module = cfg.module();
 
-	auto & cfg = entry->cfg();
-	auto & module = cfg.module();
-
-	auto sccs = find_sccs(entry, exit);
-	for (auto scc : sccs) {
-		auto s = find_scc_structure(scc);
+		auto s = find_scc_structure(*loop);
 
 		if (is_tcloop(s)) {
-			restructure(*s.begin_enodes(), (*s.begin_xedges())->source(), loops);
-			loops.push_back(extract_tcloop(*s.begin_enodes(), (*s.begin_xedges())->source()));
+			auto ne = *s.begin_enodes();
+			auto nx = (*s.begin_xedges())->source();
+			restructure(ne, nx, forest, loop, loops, nvariables);
+			loops.push_back(extract_tcloop(ne, nx));
 			continue;
 		}
 
-		auto ev = s.nenodes() > 1 ? create_tvariable(jive::ctltype(s.nenodes()), module) : nullptr;
-		auto rv = create_rvariable(module);
-		auto xv = s.nxnodes() > 1 ? create_qvariable(jive::ctltype(s.nxnodes()), module) : nullptr;
+		auto ev = s.nenodes() > 1
+			? create_tvariable(jive::ctltype(s.nenodes()), module, nvariables)
+			: nullptr;
+		auto rv = create_rvariable(module, nvariables);
+		auto xv = s.nxnodes() > 1
+			? create_qvariable(jive::ctltype(s.nxnodes()), module, nvariables)
+			: nullptr;
 		auto new_ne = basic_block::create(cfg);
 		auto new_nr = basic_block::create(cfg);
 		auto new_nx = basic_block::create(cfg);
@@ -440,7 +396,7 @@ restructure_loops(jlm::cfg_node * entry, jlm::cfg_node * exit, std::vector<tcloo
 		restructure_loop_exit(s, new_nr, new_nx, rv, xv);
 		restructure_loop_repetition(s, new_nr, new_nr, ev, rv);
 
-		restructure(new_ne, new_nr, loops);
+		restructure(new_ne, new_nr, forest, loop, loops, nvariables);
 		loops.push_back(extract_tcloop(new_ne, new_nr));
 	}
 }
@@ -490,9 +446,13 @@ find_dominator_graph(const jlm::cfg_edge * edge)
 	return nodes;
 }
 
+/*
+	The continuation points and edges are ordered by their indices, such that
+	equal cfgs are restructured equally.
+*/
 struct continuation {
-	std::unordered_set<jlm::cfg_node*> points;
-	std::unordered_map<jlm::cfg_edge*, std::unordered_set<jlm::cfg_edge*>> edges;
+	std::set<jlm::cfg_node*, index_order> points;
+	std::unordered_map<jlm::cfg_edge*, std::set<jlm::cfg_edge*, index_order>> edges;
 };
 
 static inline continuation
@@ -527,7 +487,7 @@ compute_continuation(jlm::cfg_node * hb)
 }
 
 static inline void
-restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
+restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit, size_t & nvariables)
 {
 	auto & cfg = entry->cfg();
 	auto & module = cfg.module();
@@ -553,7 +513,7 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 			if (cedges.size() == 1) {
 				auto e = *cedges.begin();
 				JLM_DEBUG_ASSERT(e != it.edge());
-				restructure_branches(it->sink(), e->source());
+				restructure_branches(it->sink(), e->source(), nvariables);
 				continue;
 			}
 
@@ -562,16 +522,16 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 			null->add_outedge(cpoint);
 			for (const auto & e : cedges)
 				e->divert(null);
-			restructure_branches(it->sink(), null);
+			restructure_branches(it->sink(), null, nvariables);
 		}
 
 		/* restructure tail subgraph */
-		restructure_branches(cpoint, exit);
+		restructure_branches(cpoint, exit, nvariables);
 		return;
 	}
 
 	/* insert new continuation point */
-	auto p = create_pvariable(jive::ctltype(c.points.size()), module);
+	auto p = create_pvariable(jive::ctltype(c.points.size()), module, nvariables);
 	auto cn = basic_block::create(cfg);
 	append_branch(cn, p);
 	std::unordered_map<cfg_node*, size_t> indices;
@@ -593,11 +553,11 @@ restructure_branches(jlm::cfg_node * entry, jlm::cfg_node * exit)
 			e->divert(bb);
 		}
 
-		restructure_branches(it->sink(), null);
+		restructure_branches(it->sink(), null, nvariables);
 	}
 
 	/* restructure tail subgraph */
-	restructure_branches(cn, exit);
+	restructure_branches(cn, exit, nvariables);
 }
 
 void
@@ -605,8 +565,10 @@ restructure_loops(jlm::cfg * cfg)
 {
 	JLM_DEBUG_ASSERT(is_closed(*cfg));
 
+	size_t nvariables = 0;
+	loopforest forest(*cfg);
 	std::vector<tcloop> loops;
-	restructure_loops(cfg->entry(), cfg->exit(), loops);
+	restructure_loops(forest, nullptr, loops, nvariables);
 
 	for (const auto & l : loops)
 		reinsert_tcloop(l);
@@ -616,15 +578,22 @@ void
 restructure_branches(jlm::cfg * cfg)
 {
 	JLM_DEBUG_ASSERT(is_acyclic(*cfg));
-	restructure_branches(cfg->entry(), cfg->exit());
+	size_t nvariables = 0;
+	restructure_branches(cfg->entry(), cfg->exit(), nvariables);
 	JLM_DEBUG_ASSERT(is_proper_structured(*cfg));
 }
 
 static inline void
-restructure(jlm::cfg_node * entry, jlm::cfg_node * exit, std::vector<tcloop> & tcloops)
+restructure(
+	jlm::cfg_node * entry,
+	jlm::cfg_node * exit,
+	const loopforest & forest,
+	const cfg_loop * loop,
+	std::vector<tcloop> & tcloops,
+	size_t & nvariables)
 {
-	restructure_loops(entry, exit, tcloops);
-	restructure_branches(entry, exit);
+	restructure_loops(forest, loop, tcloops, nvariables);
+	restructure_branches(entry, exit, nvariables);
 }
 
 void
@@ -632,12 +601,17 @@ restructure(jlm::cfg * cfg)
 {
 	JLM_DEBUG_ASSERT(is_closed(*cfg));
 
+	size_t nvariables = 0;
+	loopforest forest(*cfg);
 	std::vector<tcloop> tcloops;
-	restructure(cfg->entry(), cfg->exit(), tcloops);
+	restructure(cfg->entry(), cfg->exit(), forest, nullptr, tcloops, nvariables);
 
 	for (const auto & l : tcloops)
 		reinsert_tcloop(l);
 
+	/* reclaim the slots of the nodes removed by restructuring and its preparation */
+	cfg->compact();
+
 	JLM_DEBUG_ASSERT(is_proper_structured(*cfg));
 }
 
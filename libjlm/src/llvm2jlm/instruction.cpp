@@ -98,7 +98,7 @@ convert_int_constant(
 
 	jive::bitvalue_repr v = convert_apint(constant->getValue());
 	auto r = ctx.module().create_variable(*convert_type(c->getType(), ctx));
-	tacs.push_back(tac::create(jive::bitconstant_op(v), {}, {r}));
+	tacs.push_back(tac::create(ctx.module().operations(), jive::bitconstant_op(v), {}, {r}));
 	return r;
 }
 
@@ -399,7 +399,8 @@ convert_branch_instruction(llvm::Instruction * instruction, tacsvector_t & tacs,
 	auto c = convert_value(i->getCondition(), tacs, ctx);
 	auto nbits = i->getCondition()->getType()->getIntegerBitWidth();
 	auto op = jive::match_op(nbits, {{1, 1}}, 0, 2);
-	tacs.push_back(tac::create(op, {c}, create_result_variables(ctx.module(), op)));
+	tacs.push_back(tac::create(ctx.module().operations(), op, {c},
+		create_result_variables(ctx.module(), op)));
 	tacs.push_back(create_branch_tac(2,  tacs.back()->result(0)));
 
 	return nullptr;
@@ -426,7 +427,8 @@ convert_switch_instruction(llvm::Instruction * instruction, tacsvector_t & tacs,
 	auto c = convert_value(i->getCondition(), tacs, ctx);
 	auto nbits = i->getCondition()->getType()->getIntegerBitWidth();
 	auto op = jive::match_op(nbits, mapping, n, n+1);
-	tacs.push_back(tac::create(op, {c}, create_result_variables(ctx.module(), op)));
+	tacs.push_back(tac::create(ctx.module().operations(), op, {c},
+		create_result_variables(ctx.module(), op)));
 	tacs.push_back((create_branch_tac(n+1, tacs.back()->result(0))));
 
 	return nullptr;
@@ -491,7 +493,8 @@ convert_icmp_instruction(llvm::Instruction * instruction, tacsvector_t & tacs, c
 		tacs.push_back(vectorbinary_op::create(*static_cast<jive::binary_op*>(binop.get()),
 			op1, op2, result));
 	} else {
-		tacs.push_back(tac::create(*static_cast<jive::simple_op*>(binop.get()),
+		tacs.push_back(tac::create(ctx.module().operations(),
+			*static_cast<jive::simple_op*>(binop.get()),
 			{op1, op2}, {result}));
 	}
 
@@ -528,7 +531,7 @@ convert_fcmp_instruction(llvm::Instruction * instruction, tacsvector_t & tacs, c
 	if (t->isVectorTy())
 		tacs.push_back(vectorbinary_op::create(operation, op1, op2, r));
 	else
-		tacs.push_back(tac::create(operation, {op1, op2}, {r}));
+		tacs.push_back(tac::create(ctx.module().operations(), operation, {op1, op2}, {r}));
 
 	return tacs.back()->result(0);
 }
@@ -774,7 +777,8 @@ convert_binary_operator(llvm::Instruction * instruction, tacsvector_t & tacs, co
 		auto & binop = *static_cast<jive::binary_op*>(operation.get());
 		tacs.push_back(vectorbinary_op::create(binop, op1, op2, r));
 	} else {
-		tacs.push_back(tac::create(*static_cast<jive::simple_op*>(operation.get()), {op1, op2}, {r}));
+		tacs.push_back(tac::create(ctx.module().operations(),
+			*static_cast<jive::simple_op*>(operation.get()), {op1, op2}, {r}));
 	}
 
 	return tacs.back()->result(0);
@@ -906,7 +910,8 @@ convert_cast_instruction(llvm::Instruction * i, tacsvector_t & tacs, context & c
 	if (dt->isVectorTy())
 		tacs.push_back(vectorunary_op::create(*static_cast<jive::unary_op*>(unop.get()), op, r));
 	else
-		tacs.push_back(tac::create(*static_cast<jive::simple_op*>(unop.get()), {op}, {r}));
+		tacs.push_back(tac::create(ctx.module().operations(),
+			*static_cast<jive::simple_op*>(unop.get()), {op}, {r}));
 
 	return tacs.back()->result(0);
 }
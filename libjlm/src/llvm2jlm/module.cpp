@@ -15,6 +15,7 @@
 #include <jlm/llvm2jlm/instruction.hpp>
 #include <jlm/llvm2jlm/module.hpp>
 #include <jlm/llvm2jlm/type.hpp>
+#include <jlm/util/trace.hpp>
 
 #include <jive/arch/addresstype.h>
 #include <jive/rvsdg/type.h>
@@ -157,6 +158,7 @@ convert_function(llvm::Function & function, context & ctx)
 	if (function.isDeclaration())
 		return;
 
+	trace_scope scope("function", function.getName().str());
 	auto fv = static_cast<const fctvariable*>(ctx.lookup_value(&function));
 
 	ctx.set_node(fv->function());
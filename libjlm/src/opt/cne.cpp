@@ -25,7 +25,8 @@ public:
 	{}
 
 	cnestat()
-	: nnodes_before_(0), nnodes_after_(0)
+	: stat(statid::cne)
+	, nnodes_before_(0), nnodes_after_(0)
 	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
@@ -57,14 +58,14 @@ public:
 		diverttimer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("CNE ",
-			nnodes_before_, " ", nnodes_after_, " ",
-			ninputs_before_, " ", ninputs_after_, " ",
-			marktimer_.ns(), " ", diverttimer_.ns()
-		);
+		return {
+		  {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"mark_time_ns", marktimer_.ns()}, {"divert_time_ns", diverttimer_.ns()}
+		};
 	}
 
 private:
@@ -583,7 +584,7 @@ cne(rvsdg_module & rm, const stats_descriptor & sd)
 	divert(graph.root(), ctx);
 	stat.end_divert_stat(graph);
 
-	if (sd.print_cne_stat)
+	if (sd.is_enabled(statid::cne))
 		sd.print_stat(stat);
 }
 
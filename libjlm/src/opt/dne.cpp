@@ -26,7 +26,8 @@ public:
 	{}
 
 	dnestat()
-	: nnodes_before_(0), nnodes_after_(0)
+	: stat(statid::dne)
+	, nnodes_before_(0), nnodes_after_(0)
 	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
@@ -58,14 +59,14 @@ public:
 		sweeptimer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("DNE ",
-			nnodes_before_, " ", nnodes_after_, " ",
-			ninputs_before_, " ", ninputs_after_, " ",
-			marktimer_.ns(), " ", sweeptimer_.ns()
-		);
+		return {
+		  {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"mark_time_ns", marktimer_.ns()}, {"sweep_time_ns", sweeptimer_.ns()}
+		};
 	}
 
 private:
@@ -463,7 +464,7 @@ dne(rvsdg_module & rm, const stats_descriptor & sd)
 	sweep(graph, ctx);
 	ds.end_sweep_stat(graph);
 
-	if (sd.print_dne_stat)
+	if (sd.is_enabled(statid::dne))
 		sd.print_stat(ds);
 }
 }
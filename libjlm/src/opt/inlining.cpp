@@ -24,7 +24,8 @@ public:
 	{}
 
 	ilnstat()
-	: nnodes_before_(0), nnodes_after_(0)
+	: stat(statid::iln)
+	, nnodes_before_(0), nnodes_after_(0)
 	{}
 
 	void
@@ -41,10 +42,13 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("ILN ", nnodes_before_, " ", nnodes_after_, " ", timer_.ns());
+		return {
+		  {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -215,7 +219,7 @@ inlining(rvsdg_module & rm, const stats_descriptor & sd)
 	inlining(graph);
 	stat.stop(graph);
 
-	if (sd.print_iln_stat)
+	if (sd.is_enabled(statid::iln))
 		sd.print_stat(stat);
 }
 
@@ -24,7 +24,8 @@ public:
 	{}
 
 	invstat()
-	: nnodes_before_(0), nnodes_after_(0)
+	: stat(statid::inv)
+	, nnodes_before_(0), nnodes_after_(0)
 	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
@@ -44,14 +45,14 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("INV ",
-			nnodes_before_, " ", nnodes_after_, " ",
-			ninputs_before_, " ", ninputs_after_, " ",
-			timer_.ns()
-		);
+		return {
+		  {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -144,7 +145,7 @@ invariance(rvsdg_module & rm, const stats_descriptor & sd)
 	invariance(rm.graph()->root());
 	stat.end(*rm.graph());
 
-	if (sd.print_inv_stat)
+	if (sd.is_enabled(statid::inv))
 		sd.print_stat(stat);
 }
 
@@ -25,7 +25,8 @@ public:
 	{}
 
 	ivtstat()
-	: nnodes_before_(0), nnodes_after_(0)
+	: stat(statid::ivt)
+	, nnodes_before_(0), nnodes_after_(0)
 	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
@@ -45,14 +46,14 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("IVT ",
-			nnodes_before_, " ", nnodes_after_, " ",
-			ninputs_before_, " ", ninputs_after_, " ",
-			timer_.ns()
-		);
+		return {
+		  {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -301,7 +302,7 @@ invert(rvsdg_module & rm, const stats_descriptor & sd)
 	invert(rm.graph()->root());
 	stat.end(*rm.graph());
 
-	if (sd.print_ivt_stat)
+	if (sd.is_enabled(statid::ivt))
 		sd.print_stat(stat);
 }
 
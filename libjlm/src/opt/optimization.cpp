@@ -3,6 +3,7 @@
  * See COPYING for terms of redistribution.
  */
 
+#include <jlm/common.hpp>
 #include <jlm/ir/rvsdg-module.hpp>
 
 #include <jlm/opt/cne.hpp>
@@ -19,7 +20,11 @@
 #include <jlm/util/stats.hpp>
 #include <jlm/util/strfmt.hpp>
 #include <jlm/util/time.hpp>
+#include <jlm/util/trace.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
 #include <unordered_map>
 
 namespace jlm {
@@ -31,15 +36,17 @@ public:
 	{}
 
 	optimization_stat(const jlm::filepath & filename)
-	: filename_(filename)
-	, nnodes_before_(0)
-	, nnodes_after_(0)
+	: stat(statid::rvsdg_optimization)
+	, filename_(filename)
+	, nnodes_before_(0), nnodes_after_(0)
+	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
 	void
 	start(const jive::graph & graph) noexcept
 	{
 		nnodes_before_ = jive::nnodes(graph.root());
+		ninputs_before_ = jive::ninputs(graph.root());
 		timer_.start();
 	}
 
@@ -48,19 +55,25 @@ public:
 	{
 		timer_.stop();
 		nnodes_after_ = jive::nnodes(graph.root());
+		ninputs_after_ = jive::ninputs(graph.root());
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("RVSDGOPTIMIZATION ", filename_.to_str(), " ",
-			nnodes_before_, " ", nnodes_after_, " ", timer_.ns());
+		return {
+		  {"file", filename_.to_str()}
+		, {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
 	jlm::timer timer_;
 	jlm::filepath filename_;
 	size_t nnodes_before_, nnodes_after_;
+	size_t ninputs_before_, ninputs_after_;
 };
 
 static void
@@ -86,9 +99,23 @@ optimize(rvsdg_module & rm, const stats_descriptor & sd, const optimization & op
 
 
 	JLM_DEBUG_ASSERT(map.find(opt) != map.end());
+	trace_scope scope("pass", to_str(opt));
 	map[opt](rm, sd);
 }
 
+/*
+	Performs the optimizations without printing an optimization stat.
+*/
+static void
+perform(
+	rvsdg_module & rm,
+	const stats_descriptor & sd,
+	const std::vector<optimization> & opts)
+{
+	for (const auto & opt : opts)
+		optimize(rm, sd, opt);
+}
+
 void
 optimize(
 	rvsdg_module & rm,
@@ -98,12 +125,360 @@ optimize(
 	optimization_stat stat(rm.source_filename());
 
 	stat.start(*rm.graph());
-	for (const auto & opt : opts)
-		optimize(rm, sd, opt);
+	perform(rm, sd, opts);
+	stat.end(*rm.graph());
+
+	if (sd.is_enabled(statid::rvsdg_optimization))
+		sd.print_stat(stat);
+}
+
+void
+optimize(
+	rvsdg_module & rm,
+	const stats_descriptor & sd,
+	const pipeline & pl)
+{
+	optimization_stat stat(rm.source_filename());
+
+	stat.start(*rm.graph());
+	pl.run(rm, sd);
 	stat.end(*rm.graph());
 
-	if (sd.print_rvsdg_optimization)
+	if (sd.is_enabled(statid::rvsdg_optimization))
 		sd.print_stat(stat);
 }
 
+/* optimization names */
+
+std::string
+to_str(const optimization & opt)
+{
+	static std::unordered_map<optimization, const char*> map({
+	  {optimization::cne, "cne"}, {optimization::dne, "dne"}
+	, {optimization::iln, "iln"}, {optimization::inv, "inv"}
+	, {optimization::psh, "psh"}, {optimization::red, "red"}
+	, {optimization::ivt, "ivt"}, {optimization::url, "url"}
+	, {optimization::pll, "pll"}
+	});
+
+	JLM_DEBUG_ASSERT(map.find(opt) != map.end());
+	return map[opt];
+}
+
+/* pipeline classes */
+
+class repeat_stat final : public stat {
+public:
+	virtual
+	~repeat_stat()
+	{}
+
+	repeat_stat()
+	: stat(statid::repeat)
+	, niterations_(0)
+	, nnodes_before_(0)
+	, nnodes_after_(0)
+	{}
+
+	void
+	start(const jive::graph & graph) noexcept
+	{
+		nnodes_before_ = jive::nnodes(graph.root());
+		timer_.start();
+	}
+
+	void
+	end(const jive::graph & graph, size_t niterations) noexcept
+	{
+		timer_.stop();
+		niterations_ = niterations;
+		nnodes_after_ = jive::nnodes(graph.root());
+	}
+
+	virtual std::vector<statfield>
+	fields() const override
+	{
+		return {
+		  {"iterations", niterations_}
+		, {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"time_ns", timer_.ns()}
+		};
+	}
+
+private:
+	jlm::timer timer_;
+	size_t niterations_;
+	size_t nnodes_before_, nnodes_after_;
+};
+
+pipeline::~pipeline()
+{}
+
+optimization_pipeline::~optimization_pipeline()
+{}
+
+std::string
+optimization_pipeline::to_str() const
+{
+	std::string str;
+	for (const auto & opt : opts_)
+		str += (str.empty() ? "" : ",") + jlm::to_str(opt);
+
+	return str;
+}
+
+void
+optimization_pipeline::run(
+	rvsdg_module & rm,
+	const stats_descriptor & sd) const
+{
+	perform(rm, sd, opts_);
+}
+
+sequence_pipeline::~sequence_pipeline()
+{}
+
+std::string
+sequence_pipeline::to_str() const
+{
+	std::string str;
+	for (const auto & pl : pipelines_)
+		str += (str.empty() ? "" : ",") + pl->to_str();
+
+	return "(" + str + ")";
+}
+
+void
+sequence_pipeline::run(
+	rvsdg_module & rm,
+	const stats_descriptor & sd) const
+{
+	for (const auto & pl : pipelines_)
+		pl->run(rm, sd);
+}
+
+repeat_pipeline::~repeat_pipeline()
+{}
+
+std::string
+repeat_pipeline::to_str() const
+{
+	auto body = body_->to_str();
+	if (dynamic_cast<const sequence_pipeline*>(body_.get()))
+		body = body.substr(1, body.size()-2);
+
+	return strfmt("repeat[", maxiterations_, "](", body, ")");
+}
+
+void
+repeat_pipeline::run(
+	rvsdg_module & rm,
+	const stats_descriptor & sd) const
+{
+	auto & graph = *rm.graph();
+
+	repeat_stat stat;
+	stat.start(graph);
+
+	size_t n = 0;
+	while (n < maxiterations_) {
+		auto nnodes = jive::nnodes(graph.root());
+		auto ninputs = jive::ninputs(graph.root());
+
+		{
+			trace_scope scope("pipeline", strfmt("repeat iteration ", n));
+			body_->run(rm, sd);
+		}
+		n++;
+
+		if (nnodes == jive::nnodes(graph.root()) && ninputs == jive::ninputs(graph.root()))
+			break;
+	}
+
+	stat.end(graph, n);
+	if (sd.is_enabled(statid::repeat))
+		sd.print_stat(stat);
+}
+
+/* pipeline parser */
+
+class pipeline_parser final {
+public:
+	pipeline_parser(const std::string & str)
+	: pos_(0)
+	, str_(str)
+	{}
+
+	std::unique_ptr<pipeline>
+	parse()
+	{
+		auto pl = parse_sequence();
+		if (pos_ != str_.size())
+			error("unexpected character");
+
+		return pl;
+	}
+
+private:
+	/*
+		sequence := element (',' element)*
+	*/
+	std::unique_ptr<pipeline>
+	parse_sequence()
+	{
+		std::vector<std::unique_ptr<pipeline>> pipelines;
+		std::vector<optimization> opts;
+
+		do {
+			skip_whitespace();
+			auto name = parse_name();
+			if (name.empty() || name == "repeat") {
+				if (!opts.empty())
+					pipelines.push_back(optimization_pipeline::create(opts));
+				opts.clear();
+				pipelines.push_back(name.empty() ? parse_group() : parse_repeat());
+			} else {
+				opts.push_back(parse_optimization(name));
+			}
+			skip_whitespace();
+		} while (consume(','));
+
+		if (!opts.empty())
+			pipelines.push_back(optimization_pipeline::create(opts));
+
+		if (pipelines.size() == 1)
+			return std::move(pipelines[0]);
+
+		return sequence_pipeline::create(std::move(pipelines));
+	}
+
+	/*
+		group := '(' sequence ')'
+	*/
+	std::unique_ptr<pipeline>
+	parse_group()
+	{
+		expect('(');
+		auto pl = parse_sequence();
+		expect(')');
+
+		return pl;
+	}
+
+	/*
+		repeat := 'repeat' ['[' number ']'] group
+	*/
+	std::unique_ptr<pipeline>
+	parse_repeat()
+	{
+		size_t maxiterations = repeat_pipeline::default_maxiterations;
+		if (consume('[')) {
+			size_t start = pos_;
+			while (pos_ < str_.size() && isdigit(str_[pos_]))
+				pos_++;
+
+			if (start == pos_)
+				error("expected iteration count");
+
+			try {
+				maxiterations = std::stoul(str_.substr(start, pos_-start));
+			} catch (std::out_of_range &) {
+				error("iteration count out of range");
+			}
+			expect(']');
+		}
+
+		skip_whitespace();
+		return repeat_pipeline::create(parse_group(), maxiterations);
+	}
+
+	optimization
+	parse_optimization(const std::string & name)
+	{
+		static std::unordered_map<std::string, optimization> map({
+		  {"cne", optimization::cne}, {"dne", optimization::dne}
+		, {"iln", optimization::iln}, {"inv", optimization::inv}
+		, {"psh", optimization::psh}, {"red", optimization::red}
+		, {"ivt", optimization::ivt}, {"url", optimization::url}
+		, {"pll", optimization::pll}
+		});
+
+		auto it = map.find(name);
+		if (it == map.end())
+			throw jlm::error("Unknown optimization in pipeline: " + name);
+
+		return it->second;
+	}
+
+	std::string
+	parse_name()
+	{
+		size_t start = pos_;
+		while (pos_ < str_.size() && isalpha(str_[pos_]))
+			pos_++;
+
+		return str_.substr(start, pos_-start);
+	}
+
+	void
+	skip_whitespace()
+	{
+		while (pos_ < str_.size() && isspace(str_[pos_]))
+			pos_++;
+	}
+
+	bool
+	consume(char c)
+	{
+		skip_whitespace();
+		if (pos_ < str_.size() && str_[pos_] == c) {
+			pos_++;
+			return true;
+		}
+
+		return false;
+	}
+
+	void
+	expect(char c)
+	{
+		if (!consume(c))
+			error(strfmt("expected '", c, "'"));
+	}
+
+	void
+	error(const std::string & msg) const
+	{
+		throw jlm::error(strfmt("Invalid pipeline '", str_, "' at position ", pos_, ": ", msg, "."));
+	}
+
+	size_t pos_;
+	std::string str_;
+};
+
+std::unique_ptr<pipeline>
+parse_pipeline(const std::string & str)
+{
+	return pipeline_parser(str).parse();
+}
+
+/* optimization levels */
+
+std::unique_ptr<pipeline>
+create_pipeline(size_t level)
+{
+	static std::vector<const char*> levels({
+	  /* O0 */ nullptr
+	, /* O1 */ "red,cne,dne"
+	, /* O2 */ "iln,repeat[4](inv,red,cne,dne),psh,ivt,repeat[4](red,cne,dne)"
+	, /* O3 */ "iln,repeat[8](inv,red,cne,dne),psh,ivt,url,repeat[8](inv,red,cne,dne)"
+	});
+
+	auto str = levels[std::min(level, levels.size()-1)];
+	if (str == nullptr)
+		return optimization_pipeline::create({});
+
+	return parse_pipeline(str);
+}
+
 }
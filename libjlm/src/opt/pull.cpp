@@ -22,7 +22,8 @@ public:
 	{}
 
 	pullstat()
-	: ninputs_before_(0), ninputs_after_(0)
+	: stat(statid::pll)
+	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
 	void
@@ -39,13 +40,13 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("PULL ",
-			ninputs_before_, " ", ninputs_after_, " ",
-			timer_.ns()
-		);
+		return {
+		  {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -279,7 +280,7 @@ pull(rvsdg_module & rm, const stats_descriptor & sd)
 	pull(rm.graph()->root());
 	stat.end(*rm.graph());
 
-	if (sd.print_pull_stat)
+	if (sd.is_enabled(statid::pll))
 		sd.print_stat(stat);
 }
 
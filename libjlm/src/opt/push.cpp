@@ -26,7 +26,8 @@ public:
 	{}
 
 	pushstat()
-	: ninputs_before_(0), ninputs_after_(0)
+	: stat(statid::psh)
+	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
 	void
@@ -43,13 +44,13 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("PUSH ",
-			ninputs_before_, " ", ninputs_after_, " ",
-			timer_.ns()
-		);
+		return {
+		  {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -407,7 +408,7 @@ push(rvsdg_module & rm, const stats_descriptor & sd)
 	push(rm.graph()->root());
 	stat.end(*rm.graph());
 
-	if (sd.print_push_stat)
+	if (sd.is_enabled(statid::psh))
 		sd.print_stat(stat);
 }
 
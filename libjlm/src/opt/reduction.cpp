@@ -22,7 +22,8 @@ public:
 	{}
 
 	redstat()
-	: nnodes_before_(0), nnodes_after_(0)
+	: stat(statid::red)
+	, nnodes_before_(0), nnodes_after_(0)
 	, ninputs_before_(0), ninputs_after_(0)
 	{}
 
@@ -42,14 +43,14 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("RED ",
-			nnodes_before_, " ", nnodes_after_, " ",
-			ninputs_before_, " ", ninputs_after_, " ",
-			timer_.ns()
-		);
+		return {
+		  {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"ninputs_before", ninputs_before_}, {"ninputs_after", ninputs_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -136,7 +137,7 @@ reduce(rvsdg_module & rm, const stats_descriptor & sd)
 	graph.normalize();
 	stat.end(graph);
 
-	if (sd.print_reduction_stat)
+	if (sd.is_enabled(statid::red))
 		sd.print_stat(stat);
 }
 
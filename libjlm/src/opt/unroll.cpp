@@ -30,7 +30,8 @@ public:
 	{}
 
 	unrollstat()
-	: nnodes_before_(0), nnodes_after_(0)
+	: stat(statid::url)
+	, nnodes_before_(0), nnodes_after_(0)
 	{}
 
 	void
@@ -47,13 +48,13 @@ public:
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("UNROLL ",
-			nnodes_before_, " ", nnodes_after_, " ",
-			timer_.ns()
-		);
+		return {
+		  {"nnodes_before", nnodes_before_}, {"nnodes_after", nnodes_after_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
@@ -514,7 +515,7 @@ unroll(rvsdg_module & rm, const stats_descriptor & sd, size_t factor)
 	unroll(*rm.graph(), factor);
 	stat.end(*rm.graph());
 
-	if (sd.print_unroll_stat)
+	if (sd.is_enabled(statid::url))
 		sd.print_stat(stat);
 }
 
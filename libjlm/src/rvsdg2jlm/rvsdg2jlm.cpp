@@ -20,6 +20,7 @@
 #include <jlm/rvsdg2jlm/rvsdg2jlm.hpp>
 #include <jlm/util/stats.hpp>
 #include <jlm/util/time.hpp>
+#include <jlm/util/trace.hpp>
 
 #include <deque>
 
@@ -32,8 +33,13 @@ public:
 	{}
 
 	rvsdg_destruction_stat(const jlm::filepath & filename)
-	: ntacs_(0)
+	: stat(statid::rvsdg_destruction)
+	, ntacs_(0)
 	, nnodes_(0)
+	, nvariables_(0)
+	, arena_bytes_(0)
+	, noperations_(0)
+	, ntypes_(0)
 	, filename_(filename)
 	{}
 
@@ -48,22 +54,32 @@ public:
 	end(const ipgraph_module & im)
 	{
 		ntacs_ = jlm::ntacs(im);
+		nvariables_ = im.arena().nobjects();
+		arena_bytes_ = im.arena().nbytes();
+		noperations_ = im.operations().noperations();
+		ntypes_ = im.types().ntypes();
 		timer_.stop();
 	}
 
-	virtual std::string
-	to_str() const override
+	virtual std::vector<statfield>
+	fields() const override
 	{
-		return strfmt("RVSDGDESTRUCTION ",
-			filename_.to_str(), " ",
-			nnodes_, " ", ntacs_, " ",
-			timer_.ns()
-		);
+		return {
+		  {"file", filename_.to_str()}
+		, {"nnodes", nnodes_}, {"ntacs", ntacs_}
+		, {"nvariables", nvariables_}, {"arena_bytes", arena_bytes_}
+		, {"noperations", noperations_}, {"ntypes", ntypes_}
+		, {"time_ns", timer_.ns()}
+		};
 	}
 
 private:
 	size_t ntacs_;
 	size_t nnodes_;
+	size_t nvariables_;
+	size_t arena_bytes_;
+	size_t noperations_;
+	size_t ntypes_;
 	jlm::timer timer_;
 	jlm::filepath filename_;
 };
@@ -190,12 +206,12 @@ convert_simple_node(const jive::node & node, context & ctx)
 {
 	JLM_DEBUG_ASSERT(dynamic_cast<const jive::simple_op*>(&node.operation()));
 
-	std::vector<const variable*> operands;
+	tac::operandvector operands;
 	for (size_t n = 0; n < node.ninputs(); n++)
 		operands.push_back(ctx.variable(node.input(n)->origin()));
 
-	std::vector<tacvariable*> tvs;
-	std::vector<const variable*> results;
+	tac::resultvector results;
+	small_vector<tacvariable*, 1> tvs;
 	for (size_t n = 0; n < node.noutputs(); n++) {
 		auto v = ctx.module().create_tacvariable(node.output(n)->type());
 		ctx.insert(node.output(n), v);
@@ -204,10 +220,10 @@ convert_simple_node(const jive::node & node, context & ctx)
 	}
 
 	auto & op = *static_cast<const jive::simple_op*>(&node.operation());
-	ctx.lpbb()->append_last(tac::create(op, operands, results));
+	auto t = ctx.lpbb()->append_last(tac::create(op, std::move(operands), std::move(results)));
 	/* FIXME: remove again once tacvariables owner's are tacs */
 	for (const auto & tv : tvs)
-		tv->set_tac(static_cast<const basic_block*>(ctx.lpbb())->tacs().last());
+		tv->set_tac(t);
 }
 
 static void
@@ -428,6 +444,7 @@ convert_lambda_node(const jive::node & node, context & ctx)
 	auto lambda = static_cast<const lambda_node*>(&node);
 	auto & module = ctx.module();
 	auto & clg = module.ipgraph();
+	trace_scope scope("function", lambda->name());
 
 	auto f = function_node::create(clg, lambda->name(), lambda->fcttype(), lambda->linkage());
 	auto v = module.create_variable(f);
@@ -585,7 +602,7 @@ rvsdg2jlm(const rvsdg_module & rm, const stats_descriptor & sd)
 	auto im = convert_rvsdg(rm);
 	stat.end(*im);
 
-	if (sd.print_rvsdg_destruction)
+	if (sd.is_enabled(statid::rvsdg_destruction))
 		sd.print_stat(stat);
 
 	return im;
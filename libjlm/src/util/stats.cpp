@@ -3,11 +3,173 @@
  * See COPYING for terms of redistribution.
  */
 
+#include <jlm/common.hpp>
 #include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+
+#include <sys/resource.h>
+
+#include <unordered_map>
 
 namespace jlm {
 
+/* stat identifiers */
+
+struct statinfo {
+	const char * name;
+	const char * label;
+};
+
+static const std::unordered_map<statid, statinfo> &
+statinfos()
+{
+	static std::unordered_map<statid, statinfo> map({
+	  {statid::aggregation,        {"aggregation", "AGGREGATIONTIME"}}
+	, {statid::annotation,         {"annotation", "ANNOTATIONTIME"}}
+	, {statid::cache,              {"cache", "CACHE"}}
+	, {statid::cfr,                {"cfr", "CFRTIME"}}
+	, {statid::cne,                {"cne", "CNE"}}
+	, {statid::dne,                {"dne", "DNE"}}
+	, {statid::iln,                {"iln", "ILN"}}
+	, {statid::inv,                {"inv", "INV"}}
+	, {statid::ivt,                {"ivt", "IVT"}}
+	, {statid::module,             {"module", "MODULE"}}
+	, {statid::pll,                {"pll", "PULL"}}
+	, {statid::psh,                {"psh", "PUSH"}}
+	, {statid::red,                {"red", "RED"}}
+	, {statid::repeat,             {"repeat", "RVSDGREPEAT"}}
+	, {statid::rvsdg_construction, {"rvsdg-construction", "RVSDGCONSTRUCTION"}}
+	, {statid::rvsdg_destruction,  {"rvsdg-destruction", "RVSDGDESTRUCTION"}}
+	, {statid::rvsdg_optimization, {"rvsdg-optimization", "RVSDGOPTIMIZATION"}}
+	, {statid::url,                {"url", "UNROLL"}}
+	});
+
+	return map;
+}
+
+std::string
+to_str(const statid & id)
+{
+	JLM_DEBUG_ASSERT(statinfos().find(id) != statinfos().end());
+	return statinfos().at(id).name;
+}
+
+statid
+to_statid(const std::string & name)
+{
+	for (const auto & pair : statinfos()) {
+		if (pair.second.name == name)
+			return pair.first;
+	}
+
+	throw jlm::error("Unknown stat: " + name);
+}
+
+std::vector<statid>
+all_statids()
+{
+	std::vector<statid> ids;
+	for (const auto & pair : statinfos())
+		ids.push_back(pair.first);
+
+	return ids;
+}
+
+/* stat */
+
 stat::~stat()
 {}
 
+/* stats descriptor */
+
+static size_t
+peak_rss()
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	return usage.ru_maxrss;
+}
+
+static std::string
+quote_csv(const std::string & str)
+{
+	std::string quoted("\"");
+	for (const auto & c : str) {
+		if (c == '"')
+			quoted += '"';
+		quoted += c;
+	}
+
+	return quoted + "\"";
+}
+
+static std::string
+to_text(const stat & s)
+{
+	std::string str = statinfos().at(s.id()).label;
+	for (const auto & field : s.fields())
+		str += " " + field.value();
+
+	return str;
+}
+
+static std::string
+to_json(const stat & s)
+{
+	auto fields = s.fields();
+	fields.push_back({"peak_rss_kb", peak_rss()});
+
+	std::string str = "{\"stat\":\"" + to_str(s.id()) + "\"";
+	for (const auto & field : fields) {
+		auto value = field.numeric() ? field.value() : quote_json(field.value());
+		str += ",\"" + field.name() + "\":" + value;
+	}
+
+	return str + "}";
+}
+
+static std::string
+to_csv(const std::vector<statfield> & fields, bool header)
+{
+	std::string str;
+	for (const auto & field : fields) {
+		auto value = header ? field.name() : field.value();
+		if (!header && !field.numeric())
+			value = quote_csv(value);
+
+		str += "," + value;
+	}
+
+	return str;
+}
+
+void
+stats_descriptor::print_stat(const stat & s) const
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+
+	if (format_ == statformat::text) {
+		fprintf(file_.fd(), "%s\n", to_text(s).c_str());
+		return;
+	}
+
+	if (format_ == statformat::json) {
+		fprintf(file_.fd(), "%s\n", to_json(s).c_str());
+		return;
+	}
+
+	JLM_DEBUG_ASSERT(format_ == statformat::csv);
+	auto fields = s.fields();
+	fields.push_back({"peak_rss_kb", peak_rss()});
+
+	if (csvheaders_.find(s.id()) == csvheaders_.end()) {
+		fprintf(file_.fd(), "stat%s\n", to_csv(fields, true).c_str());
+		csvheaders_.insert(s.id());
+	}
+
+	fprintf(file_.fd(), "%s%s\n", to_str(s.id()).c_str(), to_csv(fields, false).c_str());
+}
+
 }
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/util/strfmt.hpp>
+#include <jlm/util/trace.hpp>
+
+namespace jlm {
+
+tracer::tracer()
+: enabled_(false)
+, origin_(clock::now())
+{}
+
+tracer &
+tracer::global() noexcept
+{
+	static tracer tracer;
+	return tracer;
+}
+
+void
+tracer::record(
+	const char * category,
+	const std::string & name,
+	const clock::time_point & start,
+	const clock::time_point & end)
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+
+	auto id = std::this_thread::get_id();
+	if (tids_.find(id) == tids_.end()) {
+		auto tid = tids_.size();
+		tids_[id] = tid;
+	}
+
+	events_.push_back({name, category, tids_[id], start, end});
+}
+
+void
+tracer::write(const jlm::filepath & path) const
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+
+	auto us = [&](const clock::time_point & tp)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(tp-origin_).count();
+	};
+
+	jlm::file f(path);
+	f.open("w");
+
+	fprintf(f.fd(), "{\"traceEvents\":[\n");
+	for (size_t n = 0; n < events_.size(); n++) {
+		auto & e = events_[n];
+		auto str = strfmt("{\"name\":", quote_json(e.name), ",\"cat\":", quote_json(e.category),
+			",\"ph\":\"X\",\"ts\":", us(e.start), ",\"dur\":", us(e.end)-us(e.start),
+			",\"pid\":1,\"tid\":", e.tid, "}");
+		fprintf(f.fd(), "%s%s\n", str.c_str(), n+1 < events_.size() ? "," : "");
+	}
+	fprintf(f.fd(), "],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+void
+tracer::clear()
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+	events_.clear();
+	origin_ = clock::now();
+}
+
+}
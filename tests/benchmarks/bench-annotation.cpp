@@ -0,0 +1,292 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "benchmark.hpp"
+
+#include <test-operation.hpp>
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/aggregation.hpp>
+#include <jlm/ir/annotation.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/liveness.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/util/time.hpp>
+
+#include <assert.h>
+
+#include <typeindex>
+#include <unordered_set>
+
+/*
+	The annotation as it was implemented before the dataflow framework, i.e.,
+	with hash sets of variables. It serves as baseline for the comparison.
+*/
+namespace hashset {
+
+using namespace jlm;
+
+typedef std::unordered_set<const variable*> variableset;
+
+struct demandset {
+	variableset top;
+	variableset bottom;
+	variableset reads;
+	variableset writes;
+};
+
+typedef std::unordered_map<const aggnode*, std::unique_ptr<demandset>> demandmap;
+
+static void
+annotaterw(const aggnode * node, demandmap & dm)
+{
+	for (const auto & child : *node)
+		annotaterw(&child, dm);
+
+	auto ds = std::make_unique<demandset>();
+	if (auto en = dynamic_cast<const entryaggnode*>(node)) {
+		for (const auto & argument : *en)
+			ds->writes.insert(argument);
+	} else if (auto xn = dynamic_cast<const exitaggnode*>(node)) {
+		for (const auto & result : *xn)
+			ds->reads.insert(result);
+	} else if (auto bn = dynamic_cast<const blockaggnode*>(node)) {
+		auto & bb = bn->tacs();
+		for (auto it = bb.rbegin(); it != bb.rend(); it++) {
+			auto tac = *it;
+			for (size_t n = 0; n < tac->nresults(); n++) {
+				ds->reads.erase(tac->result(n));
+				ds->writes.insert(tac->result(n));
+			}
+			for (size_t n = 0; n < tac->noperands(); n++)
+				ds->reads.insert(tac->operand(n));
+		}
+	} else if (is<linearaggnode>(node)) {
+		for (ssize_t n = node->nchildren()-1; n >= 0; n--) {
+			auto & cs = *dm[node->child(n)];
+			for (const auto & v : cs.writes)
+				ds->reads.erase(v);
+			ds->reads.insert(cs.reads.begin(), cs.reads.end());
+			ds->writes.insert(cs.writes.begin(), cs.writes.end());
+		}
+	} else if (is<branchaggnode>(node)) {
+		ds->reads = dm[node->child(0)]->reads;
+		ds->writes = dm[node->child(0)]->writes;
+		for (size_t n = 1; n < node->nchildren(); n++) {
+			auto & cs = *dm[node->child(n)];
+			variableset writes;
+			for (const auto & v : ds->writes) {
+				if (cs.writes.find(v) != cs.writes.end())
+					writes.insert(v);
+			}
+			ds->writes = writes;
+			ds->reads.insert(cs.reads.begin(), cs.reads.end());
+		}
+	} else {
+		JLM_DEBUG_ASSERT(is<loopaggnode>(node));
+		ds->reads = dm[node->child(0)]->reads;
+		ds->writes = dm[node->child(0)]->writes;
+	}
+
+	dm[node] = std::move(ds);
+}
+
+static void
+annotateds(const aggnode * node, variableset & pds, demandmap & dm)
+{
+	auto & ds = dm[node];
+	if (is<loopaggnode>(node)) {
+		pds.insert(ds->reads.begin(), ds->reads.end());
+		ds->bottom = ds->top = pds;
+		annotateds(node->child(0), pds, dm);
+		return;
+	}
+
+	ds->bottom = pds;
+	if (is<linearaggnode>(node)) {
+		for (ssize_t n = node->nchildren()-1; n >= 0; n--)
+			annotateds(node->child(n), pds, dm);
+	} else if (is<branchaggnode>(node)) {
+		for (size_t n = 0; n < node->nchildren(); n++) {
+			auto tmp = pds;
+			annotateds(node->child(n), tmp, dm);
+		}
+	}
+
+	for (const auto & v : ds->writes)
+		pds.erase(v);
+	pds.insert(ds->reads.begin(), ds->reads.end());
+	ds->top = pds;
+}
+
+static demandmap
+annotate(const aggnode & root)
+{
+	demandmap dm;
+	variableset ds;
+	annotaterw(&root, dm);
+	annotateds(&root, ds, dm);
+	return dm;
+}
+
+}
+
+static std::unique_ptr<jlm::aggnode>
+create_block(
+	const std::vector<const jlm::variable*> & variables,
+	size_t & seed)
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op({&vt, &vt}, {&vt});
+
+	taclist tl;
+	for (size_t n = 0; n < 8; n++) {
+		auto v1 = variables[random(seed, variables.size())];
+		auto v2 = variables[random(seed, variables.size())];
+		auto v3 = variables[random(seed, variables.size())];
+		tl.append_last(tac::create(op, {v1, v2}, {v3}));
+	}
+
+	return blockaggnode::create(std::move(tl));
+}
+
+/*
+	Creates a tree of \p nsegments segments, each consisting of a block
+	followed by a branch with two blocks. Every fourth segment is a loop.
+*/
+static std::unique_ptr<jlm::aggnode>
+create_tree(
+	size_t nsegments,
+	const std::vector<const jlm::variable*> & variables)
+{
+	using namespace jlm;
+
+	size_t seed = 42;
+	auto root = exitaggnode::create({variables[0]});
+	for (size_t n = 0; n < nsegments; n++) {
+		auto branch = branchaggnode::create();
+		branch->add_child(create_block(variables, seed));
+		branch->add_child(create_block(variables, seed));
+
+		auto segment = linearaggnode::create(create_block(variables, seed), std::move(branch));
+		if (n % 4 == 0)
+			segment = loopaggnode::create(std::move(segment));
+
+		root = linearaggnode::create(std::move(segment), std::move(root));
+	}
+
+	return linearaggnode::create(entryaggnode::create({variables[1]}), std::move(root));
+}
+
+static void
+bench_annotation(size_t nsegments, size_t nvariables)
+{
+	using namespace jlm;
+
+	valuetype vt;
+	ipgraph_module im(filepath(""), "", "");
+
+	std::vector<const variable*> variables;
+	for (size_t n = 0; n < nvariables; n++)
+		variables.push_back(im.create_variable(vt));
+
+	auto root = create_tree(nsegments, variables);
+
+	timer t1;
+	t1.start();
+	auto hdm = hashset::annotate(*root);
+	t1.stop();
+
+	timer t2;
+	t2.start();
+	auto bdm = annotate(*root);
+	t2.stop();
+
+	assert(hdm[root.get()]->top.size() == bdm[root.get()]->top.size());
+	assert(hdm[root->child(1)]->bottom.size() == bdm[root->child(1)]->bottom.size());
+
+	printf("annotation: %zu blocks %zu variables: hashset %zu us, bitvector %zu us\n",
+		3*nsegments, nvariables, t1.ns()/1000, t2.ns()/1000);
+}
+
+static void
+bench_liveness(size_t nsegments, size_t nvariables)
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op({&vt, &vt}, {&vt});
+	ipgraph_module im(filepath(""), "", "");
+
+	std::vector<const variable*> variables;
+	for (size_t n = 0; n < nvariables; n++)
+		variables.push_back(im.create_variable(vt));
+
+	size_t seed = 42;
+	auto append = [&](basic_block * bb)
+	{
+		for (size_t n = 0; n < 8; n++) {
+			auto v1 = variables[random(seed, variables.size())];
+			auto v2 = variables[random(seed, variables.size())];
+			auto v3 = variables[random(seed, variables.size())];
+			bb->append_last(tac::create(op, {v1, v2}, {v3}));
+		}
+	};
+
+	/*
+		A chain of diamonds, where every fourth diamond loops back to its head.
+	*/
+	jlm::cfg cfg(im);
+	cfg.exit()->append_result(variables[0]);
+	cfg_node * tail = basic_block::create(cfg);
+	cfg.exit()->divert_inedges(tail);
+	for (size_t n = 0; n < nsegments; n++) {
+		auto head = basic_block::create(cfg);
+		auto left = basic_block::create(cfg);
+		auto right = basic_block::create(cfg);
+		auto join = basic_block::create(cfg);
+		append(head);
+		append(left);
+		append(right);
+
+		tail->add_outedge(head);
+		head->add_outedge(left);
+		head->add_outedge(right);
+		left->add_outedge(join);
+		right->add_outedge(join);
+		if (n % 4 == 0)
+			join->add_outedge(head);
+		tail = join;
+	}
+	tail->add_outedge(cfg.exit());
+
+	timer t;
+	t.start();
+	auto live = liveness::create(cfg);
+	t.stop();
+
+	printf("liveness: %zu blocks %zu variables: %zu iterations, %zu us\n",
+		cfg.nnodes(), nvariables, live->niterations(), t.ns()/1000);
+}
+
+static int
+bench()
+{
+	bench_annotation(250, 1000);
+	bench_annotation(250, 4000);
+	bench_annotation(1000, 4000);
+
+	bench_liveness(1000, 1000);
+	bench_liveness(1000, 4000);
+	bench_liveness(4000, 8000);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("benchmarks/bench-annotation", bench)
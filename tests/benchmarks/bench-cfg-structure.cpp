@@ -0,0 +1,135 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "benchmark.hpp"
+
+#include <test-registry.hpp>
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/cfg-structure.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+
+#include <assert.h>
+
+/*
+	Creates a region of nested linear sequences, branches and tail-controlled
+	loops, and returns its entry and exit node.
+*/
+static std::pair<jlm::cfg_node*, jlm::cfg_node*>
+create_region(jlm::cfg & cfg, size_t depth, size_t & seed)
+{
+	using namespace jlm;
+
+	switch (depth == 0 ? 0 : random(seed, 4)) {
+	case 1:
+	{
+		auto r1 = create_region(cfg, depth-1, seed);
+		auto r2 = create_region(cfg, depth-1, seed);
+		r1.second->add_outedge(r2.first);
+		return {r1.first, r2.second};
+	}
+	case 2:
+	{
+		auto split = basic_block::create(cfg);
+		auto join = basic_block::create(cfg);
+		size_t nalternatives = 2 + random(seed, 2);
+		for (size_t n = 0; n < nalternatives; n++) {
+			auto r = create_region(cfg, depth-1, seed);
+			split->add_outedge(r.first);
+			r.second->add_outedge(join);
+		}
+		return {split, join};
+	}
+	case 3:
+	{
+		auto head = basic_block::create(cfg);
+		auto r = create_region(cfg, depth-1, seed);
+		auto exit = basic_block::create(cfg);
+		head->add_outedge(r.first);
+		r.second->add_outedge(exit);
+		r.second->add_outedge(head);
+		return {head, exit};
+	}
+	default:
+	{
+		auto bb = basic_block::create(cfg);
+		return {bb, bb};
+	}
+	}
+}
+
+/*
+	Creates a cfg with a sequence of \p nregions regions. Afterwards, \p nedges
+	random edges are added.
+*/
+static void
+create_cfg(jlm::cfg & cfg, size_t nregions, size_t depth, size_t nedges, size_t & seed)
+{
+	using namespace jlm;
+
+	cfg_node * tail = basic_block::create(cfg);
+	cfg.exit()->divert_inedges(tail);
+	for (size_t n = 0; n < nregions; n++) {
+		auto r = create_region(cfg, depth, seed);
+		tail->add_outedge(r.first);
+		tail = r.second;
+	}
+	tail->add_outedge(cfg.exit());
+
+	std::vector<cfg_node*> nodes;
+	for (auto & node : cfg)
+		nodes.push_back(&node);
+
+	for (size_t n = 0; n < nedges; n++) {
+		auto source = nodes[random(seed, nodes.size())];
+		auto sink = random(seed, 8) == 0 ? cfg.exit() : nodes[random(seed, nodes.size())];
+		source->add_outedge(sink);
+	}
+}
+
+static void
+bench_structure(size_t nregions, size_t depth, size_t nedges)
+{
+	using namespace jlm;
+
+	size_t seed = 42;
+	ipgraph_module im(filepath(""), "", "");
+	jlm::cfg cfg(im);
+	create_cfg(cfg, nregions, depth, nedges, seed);
+
+	bool structured, proper_structured, reducible;
+	auto us1 = measure_us([&]() {
+		structured = is_structured(cfg);
+		proper_structured = is_proper_structured(cfg);
+		reducible = is_reducible(cfg);
+	});
+
+	auto us2 = measure_us([&]() {
+		is_structured(cfg);
+		is_proper_structured(cfg);
+		is_reducible(cfg);
+	});
+
+	printf("structure: %zu nodes (%s%s%s): worklist %zu us, cached %zu us\n",
+		cfg.nnodes(),
+		structured ? "structured " : "",
+		proper_structured ? "proper " : "",
+		reducible ? "reducible" : "irreducible",
+		us1, us2);
+}
+
+static int
+bench()
+{
+	bench_structure(100, 4, 0);
+	bench_structure(500, 4, 0);
+	bench_structure(500, 4, 2);
+	bench_structure(2000, 4, 0);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("benchmarks/bench-cfg-structure", bench)
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "benchmark.hpp"
+
+#include <test-registry.hpp>
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/domtree.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+
+#include <assert.h>
+
+#include <unordered_map>
+
+/*
+	Creates a chain of \p nnodes nodes. Every \p nth node has an additional
+	edge to a random node of the chain.
+*/
+static void
+create_cfg(jlm::cfg & cfg, size_t nnodes, size_t nth)
+{
+	using namespace jlm;
+
+	std::vector<basic_block*> nodes;
+	for (size_t n = 0; n < nnodes; n++)
+		nodes.push_back(basic_block::create(cfg));
+
+	cfg.exit()->divert_inedges(nodes[0]);
+	for (size_t n = 0; n < nnodes-1; n++)
+		nodes[n]->add_outedge(nodes[n+1]);
+	nodes.back()->add_outedge(cfg.exit());
+
+	size_t seed = 42;
+	for (size_t n = 0; n < nnodes-1; n += nth) {
+		auto sink = nodes[random(seed, nnodes)];
+		if (sink != nodes[n+1])
+			nodes[n]->add_outedge(sink);
+	}
+}
+
+/*
+	Answers a dominance query by walking the dominator tree.
+*/
+static bool
+dominates(const jlm::domnode * n1, const jlm::domnode * n2)
+{
+	while (n2->depth() > n1->depth())
+		n2 = n2->parent();
+
+	return n1 == n2;
+}
+
+static void
+collect(
+	const jlm::domnode * node,
+	std::unordered_map<const jlm::cfg_node*, const jlm::domnode*> & map)
+{
+	std::vector<const jlm::domnode*> worklist({node});
+	while (!worklist.empty()) {
+		auto node = worklist.back();
+		worklist.pop_back();
+		map[node->node()] = node;
+		for (const auto & child : *node)
+			worklist.push_back(child.get());
+	}
+}
+
+static void
+bench_domtree(size_t nnodes, size_t nth, size_t nqueries)
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+	jlm::cfg cfg(im);
+	create_cfg(cfg, nnodes, nth);
+
+	std::unique_ptr<dominators> doms;
+	auto us1 = measure_us([&]() { doms = dominators::create(cfg); });
+
+	std::unique_ptr<domnode> root;
+	auto us2 = measure_us([&]() { root = domtree(cfg); });
+
+	std::unordered_map<const cfg_node*, const domnode*> map;
+	collect(root.get(), map);
+
+	std::vector<std::pair<const cfg_node*, const cfg_node*>> queries;
+	size_t seed = 7;
+	for (size_t n = 0; n < nqueries; n++) {
+		auto n1 = cfg.node(random(seed, cfg.nindices()));
+		auto n2 = cfg.node(random(seed, cfg.nindices()));
+		queries.push_back({n1, n2});
+	}
+
+	size_t ndominated1 = 0;
+	auto us3 = measure_us([&]() {
+		for (const auto & query : queries)
+			ndominated1 += dominates(map[query.first], map[query.second]);
+	});
+
+	size_t ndominated2 = 0;
+	auto us4 = measure_us([&]() {
+		for (const auto & query : queries)
+			ndominated2 += doms->dominates(query.first, query.second);
+	});
+	assert(ndominated1 == ndominated2);
+
+	size_t nfrontier = 0;
+	auto us5 = measure_us([&]() {
+		for (const auto & node : doms->preorder())
+			nfrontier += doms->frontier(node).size();
+	});
+
+	printf("domtree: %zu nodes: dominators %zu us, domnode tree %zu us\n",
+		cfg.nnodes(), us1, us2);
+	printf("dominates: %zu queries: tree walk %zu us, numbering %zu us\n",
+		nqueries, us3, us4);
+	printf("frontiers: %zu nodes: %zu frontier nodes, %zu us\n",
+		cfg.nnodes(), nfrontier, us5);
+}
+
+static int
+bench()
+{
+	bench_domtree(1000, 4, 100000);
+	bench_domtree(10000, 4, 100000);
+	bench_domtree(10000, 64, 100000);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("benchmarks/bench-domtree", bench)
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "benchmark.hpp"
+
+#include <test-registry.hpp>
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/cfg-structure.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/jlm2rvsdg/restructuring.hpp>
+
+#include <assert.h>
+
+/*
+	Creates a loop kernel with \p depth nested loops and returns its entry and
+	exit node. Loops alternate between tail-controlled and head-controlled
+	loops, and every loop body contains a branch.
+*/
+static std::pair<jlm::cfg_node*, jlm::cfg_node*>
+create_kernel(jlm::cfg & cfg, size_t depth, size_t & seed)
+{
+	using namespace jlm;
+
+	auto split = basic_block::create(cfg);
+	auto join = basic_block::create(cfg);
+	size_t nalternatives = 2 + random(seed, 2);
+	for (size_t n = 0; n < nalternatives; n++) {
+		auto bb = basic_block::create(cfg);
+		split->add_outedge(bb);
+		bb->add_outedge(join);
+	}
+
+	if (depth == 0)
+		return {split, join};
+
+	auto inner = create_kernel(cfg, depth-1, seed);
+	auto head = basic_block::create(cfg);
+	auto tail = basic_block::create(cfg);
+	auto exit = basic_block::create(cfg);
+	head->add_outedge(split);
+	join->add_outedge(inner.first);
+	inner.second->add_outedge(tail);
+	if (depth % 2 == 0) {
+		tail->add_outedge(exit);
+		tail->add_outedge(head);
+	} else {
+		head->add_outedge(exit);
+		tail->add_outedge(head);
+	}
+
+	return {head, exit};
+}
+
+static void
+create_cfg(jlm::cfg & cfg, size_t nkernels, size_t depth)
+{
+	using namespace jlm;
+
+	size_t seed = 42;
+	cfg_node * tail = basic_block::create(cfg);
+	cfg.exit()->divert_inedges(tail);
+	for (size_t n = 0; n < nkernels; n++) {
+		auto k = create_kernel(cfg, depth, seed);
+		tail->add_outedge(k.first);
+		tail = k.second;
+	}
+	tail->add_outedge(cfg.exit());
+}
+
+static void
+bench_restructure(size_t nkernels, size_t depth)
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+	jlm::cfg cfg(im);
+	create_cfg(cfg, nkernels, depth);
+	size_t nnodes = cfg.nnodes();
+
+	auto us = measure_us([&]() { restructure(&cfg); });
+	assert(is_proper_structured(cfg));
+
+	printf("restructure: %zu kernels of depth %zu (%zu nodes): %zu us\n",
+		nkernels, depth, nnodes, us);
+}
+
+static int
+bench()
+{
+	bench_restructure(100, 4);
+	bench_restructure(10, 100);
+	bench_restructure(1, 1000);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("benchmarks/bench-restructuring", bench)
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef TESTS_BENCHMARKS_BENCHMARK_HPP
+#define TESTS_BENCHMARKS_BENCHMARK_HPP
+
+#include <jlm/util/time.hpp>
+
+#include <stddef.h>
+
+/*
+	A linear congruential generator, such that the benchmarks are reproducible.
+	Returns a number in [0, n).
+*/
+static inline size_t
+random(size_t & seed, size_t n)
+{
+	seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+	return (seed >> 33) % n;
+}
+
+/*
+	Returns the time in microseconds it takes to invoke f.
+*/
+template <class F> static inline size_t
+measure_us(F f)
+{
+	jlm::timer t;
+	t.start();
+	f();
+	t.stop();
+	return t.ns()/1000;
+}
+
+#endif
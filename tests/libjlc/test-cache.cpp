@@ -0,0 +1,73 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlc/cache.hpp>
+
+#include <assert.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+static void
+write(const jlm::filepath & path, const std::string & content)
+{
+	std::ofstream ofs(path.to_str());
+	ofs << content;
+}
+
+static std::string
+read(const jlm::filepath & path)
+{
+	std::ifstream ifs(path.to_str());
+	std::stringstream ss;
+	ss << ifs.rdbuf();
+	return ss.str();
+}
+
+static void
+test_sha1()
+{
+	assert(jlm::sha1("") == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+	assert(jlm::sha1("abc") == "a9993e364706816aba3e25717850c26c9cd0d89d");
+	assert(jlm::sha1(std::string(1000, 'a')) == "291e9a6c66994949b57ba5e650361e98fc36b1ba");
+}
+
+static void
+test_objcache()
+{
+	jlm::objcache cache({"/tmp/jlm-test-cache"});
+	jlm::filepath ofile("/tmp/jlm-test-cache-foo.o");
+	auto key = jlm::sha1("foo");
+
+	unlink(cache.path(key).to_str().c_str());
+	unlink(ofile.to_str().c_str());
+	assert(!cache.lookup(key, ofile));
+	assert(access(ofile.to_str().c_str(), F_OK) != 0);
+
+	write(ofile, "object");
+	cache.insert(key, ofile);
+
+	unlink(ofile.to_str().c_str());
+	assert(cache.lookup(key, ofile));
+	assert(read(ofile) == "object");
+
+	unlink(ofile.to_str().c_str());
+	unlink(cache.path(key).to_str().c_str());
+	rmdir(cache.dir().to_str().c_str());
+}
+
+static int
+test()
+{
+	test_sha1();
+	test_objcache();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlc/test-cache", test)
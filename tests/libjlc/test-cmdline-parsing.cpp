@@ -79,6 +79,16 @@ test4()
 	assert(c.ofile() == "foobar.o");
 }
 
+static void
+test5()
+{
+	jlm::cmdline_options options;
+	parse_cmdline({"jlc", "-j4", "foo.c", "bar.c"}, options);
+
+	assert(options.njobs == 4);
+	assert(options.compilations.size() == 2);
+}
+
 static int
 test()
 {
@@ -86,6 +96,7 @@ test()
 	test2();
 	test3();
 	test4();
+	test5();
 
 	return 0;
 }
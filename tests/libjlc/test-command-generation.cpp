@@ -38,11 +38,63 @@ test2()
 	assert(cmd->ifiles()[0] == "foo.o" && cmd->ofile() == "foobar");
 }
 
+static void
+test3()
+{
+	jlm::cmdline_options options;
+	options.Olvl = jlm::optlvl::O2;
+	options.compilations.push_back({{"foo.c"}, {"foo.o"}, true, true, true, false});
+
+	auto pgraph = jlm::generate_commands(options);
+
+	auto node = (*pgraph->exit()->begin_inedges())->source();
+	node = (*node->begin_inedges())->source();
+	auto cmd = dynamic_cast<const jlm::optcmd*>(&node->cmd());
+	assert(cmd && cmd->optlevel() == jlm::optlvl::O2);
+	assert(cmd->to_str().find("-O2") != std::string::npos);
+	assert(cmd->to_str().find("--bc ") != std::string::npos);
+}
+
+static void
+test4()
+{
+	jlm::cmdline_options options;
+	options.in_process = true;
+	options.compilations.push_back({{"foo.c"}, {"foo.o"}, true, true, true, false});
+
+	auto pgraph = jlm::generate_commands(options);
+	assert(pgraph->nnodes() == 4);
+
+	auto node = (*pgraph->exit()->begin_inedges())->source();
+	auto cmd = dynamic_cast<const jlm::optcgencmd*>(&node->cmd());
+	assert(cmd && cmd->ofile() == "foo.o");
+	assert(cmd->optlevel() == jlm::optlvl::O0);
+}
+
+static void
+test5()
+{
+	jlm::cmdline_options options;
+	options.cachedir = {"/tmp/jlc-cache"};
+	options.compilations.push_back({{"foo.c"}, {"foo.o"}, true, true, true, false});
+
+	auto pgraph = jlm::generate_commands(options);
+	assert(pgraph->nnodes() == 3);
+
+	auto node = (*pgraph->exit()->begin_inedges())->source();
+	auto cmd = dynamic_cast<const jlm::cachecmd*>(&node->cmd());
+	assert(cmd && cmd->ofile() == "foo.o");
+	assert(cmd->pgraph().nnodes() == 5);
+}
+
 static int
 test()
 {
 	test1();
 	test2();
+	test3();
+	test4();
+	test5();
 
 	return 0;
 }
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+
+#include <assert.h>
+
+static int
+test()
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+
+	jlm::cfg cfg(im);
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb0);
+	auto e01 = bb0->add_outedge(bb1);
+	auto e02 = bb0->add_outedge(bb2);
+	auto e12 = bb1->add_outedge(bb2);
+	bb2->add_outedge(cfg.exit());
+
+	assert(bb2->ninedges() == 2 && cfg.exit()->ninedges() == 1);
+	assert(cfg.entry()->outedge(0)->sink() == bb0);
+
+	/* removing an edge reindexes the remaining outgoing edges */
+	bb0->remove_outedge(0);
+	assert(bb0->noutedges() == 1 && bb0->outedge(0) == e02);
+	assert(e02->index() == 0);
+	assert(bb1->no_predecessor());
+
+	/* removed edges are reused */
+	auto e = bb1->add_outedge(bb0);
+	assert(e == e01);
+	assert(e->source() == bb1 && e->sink() == bb0 && e->index() == 1);
+
+	/* splitting keeps the predecessors of the sink consistent */
+	auto bb3 = e12->split();
+	assert(e12->sink() == bb3 && bb3->single_successor());
+	assert(bb3->outedge(0)->sink() == bb2);
+	assert(bb2->ninedges() == 2);
+	for (auto it = bb2->begin_inedges(); it != bb2->end_inedges(); it++)
+		assert((*it)->source() == bb0 || (*it)->source() == bb3);
+
+	bb2->divert_inedges(bb1);
+	assert(bb2->no_predecessor() && bb1->ninedges() == 2);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-cfg-edges", test)
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+
+#include <assert.h>
+
+static int
+test()
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+
+	jlm::cfg cfg(im);
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+
+	assert(cfg.entry()->index() == 0 && cfg.exit()->index() == 1);
+	assert(bb0->index() == 2 && bb1->index() == 3 && bb2->index() == 4);
+	assert(cfg.node(3) == bb1);
+
+	cfg.remove_node(bb1);
+	assert(cfg.nnodes() == 2 && cfg.nindices() == 5);
+	assert(cfg.node(3) == nullptr);
+	assert(cfg.find_node(bb2).node() == bb2);
+
+	std::vector<basic_block*> nodes;
+	for (auto & node : cfg)
+		nodes.push_back(&node);
+	assert((nodes == std::vector<basic_block*>({bb0, bb2})));
+
+	auto bb3 = basic_block::create(cfg);
+	assert(bb3->index() == 5);
+
+	/* compaction reclaims the slot of bb1 and keeps the order of the nodes */
+	cfg.compact();
+	assert(cfg.nnodes() == 3 && cfg.nindices() == 5);
+	assert(bb0->index() == 2 && bb2->index() == 3 && bb3->index() == 4);
+	assert(cfg.node(3) == bb2 && cfg.find_node(bb3).node() == bb3);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-cfg-indices", test)
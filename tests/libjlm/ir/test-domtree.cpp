@@ -36,9 +36,8 @@ get_child(
 	assert(0);
 }
 
-
-static int
-test()
+static void
+test_domtree()
 {
 	using namespace jlm;
 
@@ -79,6 +78,72 @@ test()
 
 	auto dtexit = dtbb4->child(0);
 	check<0>(dtexit, cfg.exit(), {});
+}
+
+static void
+test_dominators()
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+
+	/* setup cfg */
+
+	jlm::cfg cfg(im);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+	auto bb3 = basic_block::create(cfg);
+	auto bb4 = basic_block::create(cfg);
+	auto bb5 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb1);
+	bb1->add_outedge(bb2);
+	bb1->add_outedge(bb3);
+	bb2->add_outedge(bb4);
+	bb3->add_outedge(bb4);
+	bb4->add_outedge(bb1);
+	bb4->add_outedge(cfg.exit());
+	bb5->add_outedge(bb5);
+	bb5->add_outedge(bb4);
+
+	/* verify dominators */
+
+	auto doms = dominators::create(cfg);
+
+	assert(doms->idom(cfg.entry()) == nullptr);
+	assert(doms->idom(bb1) == cfg.entry());
+	assert(doms->idom(bb2) == bb1);
+	assert(doms->idom(bb3) == bb1);
+	assert(doms->idom(bb4) == bb1);
+	assert(doms->idom(cfg.exit()) == bb4);
+	assert(doms->idom(bb5) == nullptr);
+
+	assert(doms->dominates(cfg.entry(), cfg.exit()));
+	assert(doms->dominates(bb1, bb1));
+	assert(!doms->strictly_dominates(bb1, bb1));
+	assert(doms->dominates(bb1, bb4));
+	assert(!doms->dominates(bb2, bb4));
+	assert(!doms->dominates(bb4, bb2));
+	assert(!doms->is_reachable(bb5));
+	assert(!doms->dominates(bb5, bb4));
+	assert(!doms->dominates(bb4, bb5));
+
+	/* verify dominance frontiers */
+
+	typedef std::vector<cfg_node*> nodevector;
+	assert(doms->frontier(cfg.entry()) == nodevector({}));
+	assert(doms->frontier(bb1) == nodevector({bb1}));
+	assert(doms->frontier(bb2) == nodevector({bb4}));
+	assert(doms->frontier(bb3) == nodevector({bb4}));
+	assert(doms->frontier(bb4) == nodevector({bb1}));
+	assert(doms->frontier(cfg.exit()) == nodevector({}));
+}
+
+static int
+test()
+{
+	test_domtree();
+	test_dominators();
 
 	return 0;
 }
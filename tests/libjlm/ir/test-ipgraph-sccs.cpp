@@ -0,0 +1,79 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/ipgraph.hpp>
+
+#include <assert.h>
+
+static void
+test_sccs()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+
+	ipgraph ipg;
+	auto f = function_node::create(ipg, "f", ft, linkage::external_linkage);
+	auto g = function_node::create(ipg, "g", ft, linkage::external_linkage);
+	auto h = function_node::create(ipg, "h", ft, linkage::external_linkage);
+	auto i = function_node::create(ipg, "i", ft, linkage::external_linkage);
+
+	assert(f->index() == 0 && i->index() == 3);
+
+	f->add_dependency(g);
+	g->add_dependency(h);
+	h->add_dependency(g);
+	i->add_dependency(i);
+
+	/* callees come before their callers */
+	auto sccs = ipg.find_sccs();
+	assert(sccs.size() == 3);
+	assert(sccs[0] == std::unordered_set<const ipgraph_node*>({g, h}));
+	assert(sccs[1] == std::unordered_set<const ipgraph_node*>({f}));
+	assert(sccs[2] == std::unordered_set<const ipgraph_node*>({i}));
+}
+
+static void
+test_chain()
+{
+	using namespace jlm;
+
+	size_t nnodes = 100;
+
+	valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+
+	ipgraph ipg;
+	std::vector<function_node*> nodes;
+	for (size_t n = 0; n < nnodes; n++)
+		nodes.push_back(function_node::create(ipg, "f", ft, linkage::external_linkage));
+
+	for (size_t n = 0; n < nnodes-1; n++)
+		nodes[n]->add_dependency(nodes[n+1]);
+
+	auto sccs = ipg.find_sccs();
+	assert(sccs.size() == nnodes);
+	assert(*sccs.front().begin() == nodes.back());
+	assert(*sccs.back().begin() == nodes.front());
+
+	nodes.back()->add_dependency(nodes.front());
+	sccs = ipg.find_sccs();
+	assert(sccs.size() == 1 && sccs[0].size() == nnodes);
+}
+
+static int
+test()
+{
+	test_sccs();
+	test_chain();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-ipgraph-sccs", test)
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-operation.hpp>
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/liveness.hpp>
+#include <jlm/ir/operators/operators.hpp>
+
+#include <assert.h>
+
+static bool
+equal(
+	const jlm::variableset & vs,
+	const std::vector<const jlm::variable*> & variables)
+{
+	return std::vector<const jlm::variable*>(vs.begin(), vs.end()) == variables;
+}
+
+static void
+test_loop()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op({&vt}, {&vt});
+
+	ipgraph_module im(filepath(""), "", "");
+	auto arg = im.create_variable(vt, "arg");
+	auto x = im.create_variable(vt, "x");
+	auto y = im.create_variable(vt, "y");
+
+	jlm::cfg cfg(im);
+	cfg.entry()->append_argument(arg);
+	cfg.exit()->append_result(y);
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb0);
+	bb0->add_outedge(bb1);
+	bb1->add_outedge(bb2);
+	bb1->add_outedge(cfg.exit());
+	bb2->add_outedge(bb1);
+
+	bb0->append_last(tac::create(op, {arg}, {x}));
+	bb1->append_last(tac::create(op, {x}, {y}));
+	bb2->append_last(assignment_op::create(y, x));
+
+	auto live = liveness::create(cfg);
+
+	assert(equal(live->in(cfg.entry()), {}));
+	assert(equal(live->out(cfg.entry()), {arg}));
+	assert(equal(live->in(bb0), {arg}));
+	assert(equal(live->out(bb0), {x}));
+	assert(equal(live->in(bb1), {x}));
+	assert(equal(live->out(bb1), {y}));
+	assert(equal(live->in(bb2), {y}));
+	assert(equal(live->out(bb2), {x}));
+	assert(equal(live->in(cfg.exit()), {y}));
+}
+
+static void
+test_phi()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op({}, {&vt});
+
+	ipgraph_module im(filepath(""), "", "");
+	auto arg = im.create_variable(vt, "arg");
+	auto c = im.create_variable(vt, "c");
+	auto p = im.create_variable(vt, "p");
+
+	jlm::cfg cfg(im);
+	cfg.entry()->append_argument(arg);
+	cfg.exit()->append_result(p);
+	auto bb0 = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+	auto bb3 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb0);
+	bb0->add_outedge(bb1);
+	bb0->add_outedge(bb2);
+	bb1->add_outedge(bb3);
+	bb2->add_outedge(bb3);
+	bb3->add_outedge(cfg.exit());
+
+	bb1->append_last(tac::create(op, {}, {c}));
+	bb3->append_last(phi_op::create({{c, bb1}, {arg, bb2}}, p));
+
+	auto live = liveness::create(cfg);
+
+	assert(equal(live->in(bb0), {arg}));
+	assert(equal(live->in(bb1), {}));
+	assert(equal(live->out(bb1), {c}));
+	assert(equal(live->in(bb2), {arg}));
+	assert(equal(live->out(bb2), {arg}));
+	assert(equal(live->in(bb3), {}));
+	assert(equal(live->out(bb3), {p}));
+}
+
+static int
+test()
+{
+	test_loop();
+	test_phi();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-liveness", test)
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.hpp"
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/loop-forest.hpp>
+
+#include <assert.h>
+
+#include <unordered_set>
+
+static std::unordered_set<jlm::cfg_node*>
+nodes(const jlm::cfg_loop * loop)
+{
+	return std::unordered_set<jlm::cfg_node*>(loop->begin_nodes(), loop->end_nodes());
+}
+
+static void
+test_nested()
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+
+	/*
+		bb1 -> bb2 -> bb3 -> bb4 -> exit
+		 ^      ^------'      |
+		 '--------------------'
+		bb5 -> bb5 is unreachable
+	*/
+	jlm::cfg cfg(im);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+	auto bb3 = basic_block::create(cfg);
+	auto bb4 = basic_block::create(cfg);
+	auto bb5 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb1);
+	bb1->add_outedge(bb2);
+	bb2->add_outedge(bb3);
+	bb3->add_outedge(bb2);
+	bb3->add_outedge(bb4);
+	bb4->add_outedge(bb1);
+	bb4->add_outedge(cfg.exit());
+	bb5->add_outedge(bb5);
+	bb5->add_outedge(cfg.exit());
+
+	loopforest forest(cfg);
+	assert(forest.nloops() == 2 && forest.nroots() == 1);
+
+	auto outer = forest.root(0);
+	assert(forest.loop(0) == outer);
+	assert(outer->parent() == nullptr && outer->depth() == 1);
+	assert(outer->nnodes() == 4);
+	assert(nodes(outer) == std::unordered_set<cfg_node*>({bb1, bb2, bb3, bb4}));
+	assert(outer->nheaders() == 1 && outer->header(0) == bb1);
+	assert(outer->nlatches() == 1 && outer->latch(0) == bb4);
+	assert(outer->nexits() == 1 && outer->exit(0) == bb4->outedge(1));
+
+	assert(outer->nchildren() == 1);
+	auto inner = outer->child(0);
+	assert(forest.loop(1) == inner);
+	assert(inner->parent() == outer && inner->depth() == 2);
+	assert(nodes(inner) == std::unordered_set<cfg_node*>({bb2, bb3}));
+	assert(inner->nheaders() == 1 && inner->header(0) == bb2);
+	assert(inner->nlatches() == 1 && inner->latch(0) == bb3);
+	assert(inner->nexits() == 1 && inner->exit(0) == bb3->outedge(1));
+
+	assert(outer->contains(bb3) && !inner->contains(bb1) && !outer->contains(cfg.exit()));
+	assert(forest.innermost(bb1) == outer && forest.innermost(bb3) == inner);
+	assert(forest.depth(bb1) == 1 && forest.depth(bb2) == 2 && forest.depth(cfg.entry()) == 0);
+	assert(forest.innermost(bb5) == nullptr);
+
+	/* nodes that are added later are not part of any loop */
+	auto bb6 = basic_block::create(cfg);
+	assert(forest.innermost(bb6) == nullptr && !outer->contains(bb6));
+}
+
+static void
+test_irreducible()
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+
+	/*
+		split -> bb1 <-> bb2 <- split, bb2 -> bb2, both exit
+	*/
+	jlm::cfg cfg(im);
+	auto split = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(split);
+	split->add_outedge(bb1);
+	split->add_outedge(bb2);
+	bb1->add_outedge(bb2);
+	bb1->add_outedge(cfg.exit());
+	bb2->add_outedge(bb1);
+	bb2->add_outedge(bb2);
+	bb2->add_outedge(cfg.exit());
+
+	loopforest forest(cfg);
+	assert(forest.nloops() == 1);
+
+	auto loop = forest.root(0);
+	assert(nodes(loop) == std::unordered_set<cfg_node*>({bb1, bb2}));
+	assert(loop->nheaders() == 2 && loop->header(0) == bb1 && loop->header(1) == bb2);
+	assert(loop->nlatches() == 2 && loop->latch(0) == bb1 && loop->latch(1) == bb2);
+	assert(loop->nexits() == 2);
+
+	/* the self loop of a header does not form a nested loop */
+	assert(loop->nchildren() == 0);
+}
+
+static void
+test_deep_nesting()
+{
+	using namespace jlm;
+
+	size_t depth = 1000;
+
+	ipgraph_module im(filepath(""), "", "");
+
+	/* every loop consists of a head, its nested loop, and a tail */
+	jlm::cfg cfg(im);
+	std::vector<basic_block*> heads, tails;
+	for (size_t n = 0; n < depth; n++) {
+		heads.push_back(basic_block::create(cfg));
+		tails.push_back(basic_block::create(cfg));
+	}
+
+	cfg.exit()->divert_inedges(heads[0]);
+	for (size_t n = 0; n < depth; n++) {
+		heads[n]->add_outedge(n+1 < depth ? heads[n+1] : tails[n]);
+		tails[n]->add_outedge(heads[n]);
+		tails[n]->add_outedge(n > 0 ? tails[n-1] : static_cast<cfg_node*>(cfg.exit()));
+	}
+
+	loopforest forest(cfg);
+	assert(forest.nloops() == depth && forest.nroots() == 1);
+	for (size_t n = 0; n < depth; n++) {
+		auto loop = forest.loop(n);
+		assert(loop->depth() == n+1);
+		assert(loop->nnodes() == 2*(depth-n));
+		assert(loop->nheaders() == 1 && loop->header(0) == heads[n]);
+		assert(loop->nlatches() == 1 && loop->latch(0) == tails[n]);
+		assert(loop->nchildren() == (n+1 < depth ? 1 : 0));
+		assert(forest.innermost(heads[n]) == loop && forest.innermost(tails[n]) == loop);
+	}
+}
+
+static int
+test()
+{
+	test_nested();
+	test_irreducible();
+	test_deep_nesting();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-loop-forest", test)
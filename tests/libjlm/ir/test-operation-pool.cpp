@@ -0,0 +1,52 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-operation.hpp>
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+
+#include <assert.h>
+
+static int
+test()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	test_op op1({&vt}, {&vt});
+	test_op op2({&vt, &vt}, {&vt});
+
+	ipgraph_module im(filepath(""), "", "");
+	auto v = im.create_variable(vt, "v");
+
+	jlm::cfg cfg(im);
+	auto bb = basic_block::create(cfg);
+
+	auto t1 = bb->append_last(tac::create(op1, {v}, {v}));
+	auto t2 = bb->append_last(tac::create(op1, {v}, {v}));
+	auto t3 = bb->append_first(tac::create(op2, {v, v}, {v}));
+
+	assert(&t1->operation() == &t2->operation());
+	assert(&t1->operation() != &t3->operation());
+	assert(im.operations().noperations() == 2);
+
+	auto t4 = tac::create(im.operations(), op1, {v}, {v});
+	assert(&t4->operation() == &t1->operation());
+
+	t3->replace(op1, {v}, {v});
+	assert(&t3->operation() == &t1->operation());
+
+	t2->replace(t3->operation(), {v}, {v});
+	assert(&t2->operation() == &t1->operation());
+	assert(im.operations().noperations() == 2);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-operation-pool", test)
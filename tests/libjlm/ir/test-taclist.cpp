@@ -0,0 +1,57 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-operation.hpp>
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/tac.hpp>
+
+#include <assert.h>
+
+static int
+test()
+{
+	using namespace jlm;
+
+	test_op op({}, {});
+
+	taclist tl;
+	assert(tl.ntacs() == 0 && tl.begin() == tl.end());
+
+	auto t1 = tl.insert_before(tl.end(), tac::create(op, {}, {}));
+	auto t3 = tl.insert_before(tl.end(), tac::create(op, {}, {}));
+	auto t2 = tl.insert_before(std::prev(tl.end()), tac::create(op, {}, {}));
+	tl.append_first(tac::create(op, {}, {}));
+	auto t0 = tl.first();
+
+	std::vector<tac*> tacs(tl.begin(), tl.end());
+	assert((tacs == std::vector<tac*>({t0, t1, t2, t3})));
+	std::vector<tac*> rtacs(tl.rbegin(), tl.rend());
+	assert((rtacs == std::vector<tac*>({t3, t2, t1, t0})));
+
+	/* splice */
+	taclist other;
+	other.append_last(tac::create(op, {}, {}));
+	auto t4 = other.first();
+	tl.insert_before(std::next(tl.begin()), other);
+	assert(other.ntacs() == 0 && other.first() == nullptr);
+	assert(tl.ntacs() == 5 && *std::next(tl.begin()) == t4);
+
+	/* removal */
+	auto first = tl.pop_first();
+	auto last = tl.pop_last();
+	assert(first.get() == t0 && last.get() == t3);
+	tl.drop_first();
+	assert(tl.ntacs() == 2 && tl.first() == t1 && tl.last() == t2);
+
+	/* move */
+	taclist moved(std::move(tl));
+	assert(tl.ntacs() == 0 && moved.ntacs() == 2 && moved.first() == t1);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-taclist", test)
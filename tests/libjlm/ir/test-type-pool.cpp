@@ -0,0 +1,38 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/types.hpp>
+
+#include <jive/types/bitstring/type.h>
+
+#include <assert.h>
+
+static int
+test()
+{
+	using namespace jlm;
+
+	ipgraph_module im(filepath(""), "", "");
+
+	auto v1 = im.create_variable(ptrtype(jive::bit32), "v1");
+	auto v2 = im.create_variable(ptrtype(jive::bit32));
+	auto v3 = im.create_tacvariable(jive::bit32);
+	auto v4 = im.create_variable(jive::bit32, "v4");
+	auto v5 = im.create_variable(structtype("s", false, nullptr), "v5");
+	auto v6 = im.create_variable(structtype("t", false, nullptr), "v6");
+
+	assert(&v1->type() == &v2->type());
+	assert(&v3->type() == &v4->type());
+	assert(&v1->type() != &v3->type());
+	assert(&v5->type() != &v6->type());
+	assert(im.types().ntypes() == 4);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-type-pool", test)
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-operation.hpp>
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/basic-block.hpp>
+#include <jlm/ir/cfg.hpp>
+#include <jlm/ir/ipgraph-module.hpp>
+
+#include <assert.h>
+
+#include <vector>
+
+static int
+test()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	ipgraph_module im(filepath(""), "", "");
+	auto v0 = im.create_variable(vt, "v0");
+	auto v1 = im.create_variable(vt, "v1");
+	auto v2 = im.create_variable(vt, "v2");
+
+	jlm::cfg cfg(im);
+	auto bb = basic_block::create(cfg);
+
+	auto t1 = bb->append_last(create_testop_tac({v0, v0}, {v1}));
+	auto t2 = bb->append_last(create_testop_tac({v0, v1}, {v2}));
+
+	assert(v0->nusers() == 2 && v1->nusers() == 1 && v2->nusers() == 0);
+	assert(*v1->users().begin() == t2);
+
+	/* the users are listed in the order in which they started to use the variable */
+	std::vector<tac*> users(v0->users().begin(), v0->users().end());
+	assert(users == std::vector<tac*>({t1, t2}));
+
+	/* replacing a tac updates the users of its old and new operands */
+	t1->replace(t2->operation(), {v2, v2}, {v1});
+	assert(v0->nusers() == 1 && v2->nusers() == 1);
+	assert(*v2->users().begin() == t1);
+
+	/* destructing a tac removes it from its operands */
+	bb->tacs().drop_last();
+	assert(v0->nusers() == 0 && v1->nusers() == 0);
+
+	/* tacs that are not part of a basic block are users as well */
+	{
+		auto t3 = create_testop_tac({v2, v0, v2}, {v1});
+		assert(v0->nusers() == 1 && v2->nusers() == 2);
+	}
+	assert(v0->nusers() == 0 && v2->nusers() == 1);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-variable-users", test)
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jlm/ir/ipgraph-module.hpp>
+
+#include <assert.h>
+
+static int
+test()
+{
+	using namespace jlm;
+
+	valuetype vt;
+	ipgraph_module im(filepath(""), "", "");
+
+	auto v0 = im.create_variable(vt);
+	auto v1 = im.create_variable(vt, "#p", "#");
+	auto v2 = im.create_variable(vt, "foo");
+	auto tv0 = im.create_tacvariable(vt);
+
+	assert(v0->name() == "v0");
+	assert(v1->name() == "#p1#");
+	assert(v2->name() == "foo");
+	assert(tv0->name() == "tv0");
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-variable", test)
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.hpp"
+#include "test-operation.hpp"
+#include "test-types.hpp"
+
+#include <jive/rvsdg/control.h>
+#include <jive/view.h>
+
+#include <jlm/ir/ipgraph-module.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/jlm2rvsdg/module.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+
+#include <assert.h>
+#include <unistd.h>
+
+#include <fstream>
+
+static std::unique_ptr<jlm::ipgraph_module>
+setup(size_t nfunctions)
+{
+	using namespace jlm;
+
+	valuetype vt;
+	jive::ctltype ct(2);
+	jive::fcttype ft({&vt}, {&vt});
+	auto im = ipgraph_module::create(filepath(""), "", "");
+
+	/*
+		bb1 -> bb3 -> ... -> exit
+		 ^ |
+		 | v
+		 bb2
+
+		The number of nodes between bb3 and the exit grows with every function,
+		such that the largest cfgs are the last ones in the ipgraph.
+	*/
+	for (size_t n = 0; n < nfunctions; n++) {
+		auto cfg = cfg::create(*im);
+		auto bb1 = basic_block::create(*cfg);
+		auto bb2 = basic_block::create(*cfg);
+		auto bb3 = basic_block::create(*cfg);
+
+		cfg->exit()->divert_inedges(bb1);
+		bb1->add_outedge(bb3);
+		bb1->add_outedge(bb2);
+		bb2->add_outedge(bb1);
+		cfg_node * tail = bb3;
+		for (size_t i = 0; i < n; i++) {
+			auto bb = basic_block::create(*cfg);
+			tail->add_outedge(bb);
+			tail = bb;
+		}
+		tail->add_outedge(cfg->exit());
+
+		auto x = im->create_variable(vt, "x");
+		auto p = im->create_variable(ct, "p");
+		cfg->entry()->append_argument(x);
+		bb1->append_last(create_testop_tac({x}, {p}));
+		bb1->append_last(create_branch_tac(2, p));
+		bb2->append_last(create_testop_tac({x}, {x}));
+		bb3->append_last(create_testop_tac({x}, {x}));
+		cfg->exit()->append_result(x);
+
+		auto f = function_node::create(im->ipgraph(), "f" + std::to_string(n), ft,
+			linkage::external_linkage);
+		f->add_cfg(std::move(cfg));
+		im->create_variable(f);
+	}
+
+	return im;
+}
+
+static std::vector<std::string>
+read_lines(const jlm::filepath & path)
+{
+	std::string line;
+	std::vector<std::string> lines;
+	std::ifstream ifs(path.to_str());
+	while (std::getline(ifs, line))
+		lines.push_back(line);
+
+	return lines;
+}
+
+static int
+test()
+{
+	using namespace jlm;
+
+	size_t nfunctions = 8;
+	jlm::filepath path("/tmp/jlm-test-parallel-construction.log");
+	unlink(path.to_str().c_str());
+
+	auto im1 = setup(nfunctions);
+	auto im2 = setup(nfunctions);
+
+	std::unique_ptr<rvsdg_module> rm1, rm2;
+	{
+		stats_descriptor sd;
+		rm1 = construct_rvsdg(*im1, sd);
+	}
+	{
+		stats_descriptor sd(path);
+		sd.set_format(statformat::json);
+		sd.enable(statid::cfr);
+		sd.enable(statid::aggregation);
+		sd.enable(statid::annotation);
+		rm2 = construct_rvsdg(*im2, sd, 4);
+	}
+
+	auto s1 = jive::view(rm1->graph()->root());
+	auto s2 = jive::view(rm2->graph()->root());
+	assert(s1 == s2);
+
+	/* the stats are printed in ipgraph order, independent of the schedule */
+	auto lines = read_lines(path);
+	unlink(path.to_str().c_str());
+
+	assert(lines.size() == 3*nfunctions);
+	for (size_t n = 0; n < nfunctions; n++) {
+		auto function = strfmt("\"function\":\"f", n, "\",");
+		assert(lines[3*n+0].find("{\"stat\":\"cfr\",") == 0);
+		assert(lines[3*n+1].find("{\"stat\":\"aggregation\",") == 0);
+		assert(lines[3*n+2].find("{\"stat\":\"annotation\",") == 0);
+		for (size_t i = 0; i < 3; i++)
+			assert(lines[3*n+i].find(function) != std::string::npos);
+	}
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/j2r/test-parallel-construction", test)
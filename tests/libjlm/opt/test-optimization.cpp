@@ -0,0 +1,96 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/rvsdg/graph.h>
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators/lambda.hpp>
+#include <jlm/ir/rvsdg-module.hpp>
+#include <jlm/opt/optimization.hpp>
+#include <jlm/util/stats.hpp>
+
+static const jlm::stats_descriptor sd;
+
+static jive::node *
+create_lambda(jive::region * region, const std::string & name, jive::output * x)
+{
+	using namespace jlm;
+
+	jlm::valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(region, {ft, name, linkage::external_linkage});
+	auto d = lb.add_dependency(x);
+
+	auto t1 = jlm::create_testop(lb.subregion(), {arguments[0], d}, {&vt})[0];
+	auto t2 = jlm::create_testop(lb.subregion(), {arguments[0], d}, {&vt})[0];
+	jlm::create_testop(lb.subregion(), {t2}, {&vt});
+
+	auto t3 = jlm::create_testop(lb.subregion(), {t1, t2}, {&vt})[0];
+
+	return lb.end_lambda({t3});
+}
+
+static void
+test_pipeline_parser()
+{
+	using namespace jlm;
+
+	auto pl = parse_pipeline("iln, repeat[8](red,cne,dne),(psh,inv)");
+	assert(pl->to_str() == "(iln,repeat[8](red,cne,dne),psh,inv)");
+
+	pl = parse_pipeline("repeat(cne,dne)");
+	assert(pl->to_str() == "repeat[10](cne,dne)");
+
+	for (auto str : {"", "foo", "cne,", "repeat[](cne)", "repeat[2]cne", "(cne",
+		"repeat[99999999999999999999](cne)"}) {
+		bool thrown = false;
+		try {
+			parse_pipeline(str);
+		} catch (jlm::error &) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+}
+
+static void
+test_pipeline_fixed_point()
+{
+	using namespace jlm;
+
+	jlm::valuetype vt;
+
+	rvsdg_module rm(jlm::filepath(""), "", "");
+	auto & graph = *rm.graph();
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({vt, "x"});
+	auto lambda = create_lambda(graph.root(), "f", x);
+	graph.add_export(lambda->output(0), {lambda->output(0)->type(), "f"});
+
+	auto pl = parse_pipeline("repeat[4](cne,dne)");
+	jlm::optimize(rm, sd, *pl);
+
+	auto subregion = static_cast<jive::structural_node*>(lambda)->subregion(0);
+	assert(subregion->nodes.size() == 2);
+}
+
+static int
+test()
+{
+	test_pipeline_parser();
+	test_pipeline_fixed_point();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-optimization", test)
@@ -12,6 +12,7 @@
 #include <jlm/ir/cfg-structure.hpp>
 #include <jlm/ir/ipgraph-module.hpp>
 #include <jlm/ir/print.hpp>
+#include <jlm/util/scc.hpp>
 
 #include <assert.h>
 
@@ -72,11 +73,130 @@ test_is_structured()
 	assert(is_structured(cfg));
 }
 
+static void
+test_structure_cache()
+{
+	using namespace jlm;
+
+	ipgraph_module module(filepath(""), "", "");
+
+	jlm::cfg cfg(module);
+	auto split = basic_block::create(cfg);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(split);
+	split->add_outedge(bb1);
+	split->add_outedge(bb2);
+	bb1->add_outedge(cfg.exit());
+	bb2->add_outedge(cfg.exit());
+
+	auto s = &structure(cfg);
+	assert(s->is_structured() && s->is_proper_structured() && s->is_reducible());
+	assert(&structure(cfg) == s);
+
+	/* a loop with two entries renders the cfg irreducible */
+	bb1->add_outedge(bb2);
+	bb2->add_outedge(bb1);
+	assert(!is_structured(cfg));
+	assert(!is_proper_structured(cfg));
+	assert(!is_reducible(cfg));
+
+	/* diverting an edge of the second entry makes it reducible again */
+	split->outedge(1)->divert(bb1);
+	assert(!is_structured(cfg));
+	assert(is_reducible(cfg));
+}
+
+static void
+test_unreachable_selfloop()
+{
+	using namespace jlm;
+
+	ipgraph_module module(filepath(""), "", "");
+
+	jlm::cfg cfg(module);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb1);
+	bb1->add_outedge(cfg.exit());
+	bb2->add_outedge(bb2);
+
+	assert(!is_structured(cfg));
+	assert(!is_proper_structured(cfg));
+	assert(!is_reducible(cfg));
+}
+
+static void
+test_find_sccs()
+{
+	using namespace jlm;
+
+	ipgraph_module module(filepath(""), "", "");
+
+	/* setup cfg */
+
+	jlm::cfg cfg(module);
+	auto bb1 = basic_block::create(cfg);
+	auto bb2 = basic_block::create(cfg);
+	auto bb3 = basic_block::create(cfg);
+	auto bb4 = basic_block::create(cfg);
+
+	cfg.exit()->divert_inedges(bb1);
+	bb1->add_outedge(bb2);
+	bb2->add_outedge(bb2);
+	bb2->add_outedge(bb3);
+	bb3->add_outedge(bb4);
+	bb4->add_outedge(bb3);
+	bb4->add_outedge(cfg.exit());
+
+	/* verify sccs */
+
+	auto sccs = find_sccs(cfg);
+	assert(sccs.size() == 2);
+	assert(sccs[0] == std::unordered_set<cfg_node*>({bb3, bb4}));
+	assert(sccs[1] == std::unordered_set<cfg_node*>({bb2}));
+
+	/* the search does not pass through the exit node */
+	sccfinder finder;
+	sccs = find_sccs(bb1, bb4, finder);
+	assert(sccs.size() == 1 && sccs[0] == std::unordered_set<cfg_node*>({bb2}));
+}
+
+static void
+test_find_sccs_chain()
+{
+	using namespace jlm;
+
+	size_t nnodes = 100;
+	ipgraph_module module(filepath(""), "", "");
+
+	jlm::cfg cfg(module);
+	std::vector<basic_block*> nodes;
+	for (size_t n = 0; n < nnodes; n++)
+		nodes.push_back(basic_block::create(cfg));
+
+	cfg.exit()->divert_inedges(nodes[0]);
+	for (size_t n = 0; n < nnodes-1; n++)
+		nodes[n]->add_outedge(nodes[n+1]);
+	nodes.back()->add_outedge(cfg.exit());
+	assert(is_acyclic(cfg));
+
+	nodes.back()->add_outedge(nodes[0]);
+	auto sccs = find_sccs(cfg);
+	assert(sccs.size() == 1 && sccs[0].size() == nnodes);
+}
+
 static int
 verify()
 {
 	test_straightening();
 	test_is_structured();
+	test_structure_cache();
+	test_unreachable_selfloop();
+	test_find_sccs();
+	test_find_sccs_chain();
 
 	return 0;
 }
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/common.hpp>
+#include <jlm/driver/passgraph.hpp>
+
+#include <assert.h>
+
+#include <algorithm>
+#include <mutex>
+
+class testcmd final : public jlm::command {
+public:
+	virtual
+	~testcmd()
+	{}
+
+	testcmd(
+		std::vector<std::string> & trace,
+		std::mutex & mutex,
+		const std::string & name,
+		bool fail)
+	: fail_(fail)
+	, name_(name)
+	, mutex_(mutex)
+	, trace_(trace)
+	{}
+
+	virtual std::string
+	to_str() const override
+	{
+		return name_;
+	}
+
+	virtual void
+	run() const override
+	{
+		if (fail_)
+			throw jlm::error("Failed: " + name_);
+
+		std::lock_guard<std::mutex> guard(mutex_);
+		trace_.push_back(name_);
+	}
+
+	static jlm::passgraph_node *
+	create(
+		jlm::passgraph * pgraph,
+		std::vector<std::string> & trace,
+		std::mutex & mutex,
+		const std::string & name,
+		bool fail = false)
+	{
+		return jlm::passgraph_node::create(pgraph,
+			std::make_unique<testcmd>(trace, mutex, name, fail));
+	}
+
+private:
+	bool fail_;
+	std::string name_;
+	std::mutex & mutex_;
+	std::vector<std::string> & trace_;
+};
+
+static size_t
+index(const std::vector<std::string> & trace, const std::string & name)
+{
+	auto it = std::find(trace.begin(), trace.end(), name);
+	assert(it != trace.end());
+	return it - trace.begin();
+}
+
+static void
+test_dependencies(size_t njobs)
+{
+	std::mutex mutex;
+	std::vector<std::string> trace;
+
+	/*
+		Two chains of unequal length that join in a link node.
+	*/
+	jlm::passgraph pgraph;
+	auto a1 = testcmd::create(&pgraph, trace, mutex, "a1");
+	auto b1 = testcmd::create(&pgraph, trace, mutex, "b1");
+	auto b2 = testcmd::create(&pgraph, trace, mutex, "b2");
+	auto b3 = testcmd::create(&pgraph, trace, mutex, "b3");
+	auto lnk = testcmd::create(&pgraph, trace, mutex, "lnk");
+
+	pgraph.entry()->add_edge(a1);
+	pgraph.entry()->add_edge(b1);
+	b1->add_edge(b2);
+	b2->add_edge(b3);
+	a1->add_edge(lnk);
+	b3->add_edge(lnk);
+	lnk->add_edge(pgraph.exit());
+
+	pgraph.run(njobs);
+
+	assert(trace.size() == 5);
+	assert(index(trace, "b1") < index(trace, "b2"));
+	assert(index(trace, "b2") < index(trace, "b3"));
+	assert(trace.back() == "lnk");
+}
+
+static void
+test_failure(size_t njobs)
+{
+	std::mutex mutex;
+	std::vector<std::string> trace;
+
+	jlm::passgraph pgraph;
+	auto a = testcmd::create(&pgraph, trace, mutex, "a", true);
+	auto b = testcmd::create(&pgraph, trace, mutex, "b");
+	auto lnk = testcmd::create(&pgraph, trace, mutex, "lnk");
+
+	pgraph.entry()->add_edge(a);
+	pgraph.entry()->add_edge(b);
+	a->add_edge(lnk);
+	b->add_edge(lnk);
+	lnk->add_edge(pgraph.exit());
+
+	bool thrown = false;
+	try {
+		pgraph.run(njobs);
+	} catch (jlm::error &) {
+		thrown = true;
+	}
+
+	assert(thrown);
+	assert(std::find(trace.begin(), trace.end(), "lnk") == trace.end());
+}
+
+static int
+test()
+{
+	for (size_t njobs : {1, 4}) {
+		test_dependencies(njobs);
+		test_failure(njobs);
+	}
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/test-passgraph", test)
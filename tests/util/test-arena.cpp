@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/util/arena.hpp>
+
+#include <assert.h>
+
+#include <string>
+
+class counted final {
+public:
+	~counted()
+	{
+		ndestructed++;
+	}
+
+	counted(const std::string & name)
+	: name(name)
+	{}
+
+	std::string name;
+	static size_t ndestructed;
+};
+
+size_t counted::ndestructed = 0;
+
+static int
+test()
+{
+	{
+		jlm::arena arena(128);
+
+		auto c = arena.create<counted>("foo");
+		assert(c->name == "foo");
+
+		for (size_t n = 0; n < 100; n++) {
+			auto d = arena.create<double>(n);
+			assert(reinterpret_cast<uintptr_t>(d) % alignof(double) == 0);
+			assert(*d == n);
+		}
+
+		auto large = arena.allocate(1024, 64);
+		assert(reinterpret_cast<uintptr_t>(large) % 64 == 0);
+
+		assert(arena.nobjects() == 101);
+		assert(arena.nblocks() > 1);
+		assert(arena.nbytes() >= 101*sizeof(double) + 1024);
+		assert(counted::ndestructed == 0);
+	}
+
+	assert(counted::ndestructed == 1);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("util/test-arena", test)
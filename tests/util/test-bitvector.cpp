@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/util/bitvector.hpp>
+
+#include <assert.h>
+
+#include <vector>
+
+static std::vector<size_t>
+elements(const jlm::bitvector & bv)
+{
+	return std::vector<size_t>(bv.begin(), bv.end());
+}
+
+static void
+test_sparse()
+{
+	jlm::bitvector bv1({700, 3, 64});
+	assert(!bv1.is_dense() && bv1.size() == 3);
+	assert(elements(bv1) == std::vector<size_t>({3, 64, 700}));
+	assert(bv1.contains(64) && !bv1.contains(65));
+
+	bv1.erase(64);
+	bv1.erase(5);
+	assert(elements(bv1) == std::vector<size_t>({3, 700}));
+
+	jlm::bitvector bv2({3, 4});
+	bv2 |= bv1;
+	assert(elements(bv2) == std::vector<size_t>({3, 4, 700}));
+
+	bv2 &= jlm::bitvector({4, 700, 800});
+	assert(elements(bv2) == std::vector<size_t>({4, 700}));
+
+	bv2 -= jlm::bitvector({700});
+	assert(elements(bv2) == std::vector<size_t>({4}));
+	assert(!bv2.is_dense());
+}
+
+static void
+test_dense()
+{
+	jlm::bitvector bv1;
+	for (size_t n = 0; n < 200; n += 2)
+		bv1.insert(n);
+	assert(bv1.is_dense() && bv1.size() == 100);
+	assert(bv1.contains(198) && !bv1.contains(199) && !bv1.contains(1000));
+
+	jlm::bitvector bv2({1, 3, 500});
+	auto bv3 = bv1;
+	bv3 |= bv2;
+	assert(bv3.size() == 103 && bv3.contains(1) && bv3.contains(500));
+
+	bv3 -= bv2;
+	assert(bv3 == bv1);
+
+	jlm::bitvector bv4({2, 3});
+	bv3 &= bv4;
+	assert(elements(bv3) == std::vector<size_t>({2}));
+
+	bv4 &= bv1;
+	assert(elements(bv4) == std::vector<size_t>({2}));
+	assert(bv3 == bv4);
+
+	bv1.clear();
+	assert(bv1.empty() && !bv1.is_dense() && bv1.begin() == bv1.end());
+}
+
+static void
+test_equality()
+{
+	jlm::bitvector sparse({1, 130});
+	jlm::bitvector dense;
+	for (size_t n = 0; n < 64; n++)
+		dense.insert(n);
+
+	for (size_t n = 2; n < 64; n++)
+		dense.erase(n);
+	dense.erase(0);
+	dense.insert(130);
+
+	assert(dense.is_dense() && !sparse.is_dense());
+	assert(dense == sparse && sparse == dense);
+
+	dense.insert(500);
+	dense.erase(500);
+	assert(dense == sparse);
+
+	sparse.insert(2);
+	assert(dense != sparse);
+}
+
+static int
+test()
+{
+	test_sparse();
+	test_dense();
+	test_equality();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("util/test-bitvector", test)
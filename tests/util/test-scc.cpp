@@ -0,0 +1,104 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/util/scc.hpp>
+
+#include <assert.h>
+
+#include <set>
+#include <vector>
+
+typedef std::vector<std::vector<size_t>> graph;
+
+static std::vector<std::set<size_t>>
+find_sccs(jlm::sccfinder & finder, const graph & g, size_t root)
+{
+	auto successors = [&](size_t id, std::vector<size_t> & ids)
+	{
+		ids.insert(ids.end(), g[id].begin(), g[id].end());
+	};
+
+	std::vector<std::set<size_t>> sccs;
+	auto emit = [&](jlm::sccfinder::const_iterator first, jlm::sccfinder::const_iterator last)
+	{
+		sccs.push_back(std::set<size_t>(first, last));
+	};
+
+	finder.find(root, g.size(), successors, emit);
+	return sccs;
+}
+
+static void
+test_components()
+{
+	/*
+		0 -> 1 -> 2 -> 3 -> 4
+		     ^----'    ^----'
+		     5 -> 5
+	*/
+	graph g({{1}, {2}, {1, 3}, {4}, {3}, {5}});
+
+	jlm::sccfinder finder;
+	auto sccs = find_sccs(finder, g, 0);
+	assert(sccs.size() == 3);
+	assert(sccs[0] == std::set<size_t>({3, 4}));
+	assert(sccs[1] == std::set<size_t>({1, 2}));
+	assert(sccs[2] == std::set<size_t>({0}));
+
+	assert(finder.visited(4) && !finder.visited(5));
+
+	/* visited nodes are not part of subsequent searches */
+	sccs = find_sccs(finder, g, 5);
+	assert(sccs.size() == 1 && sccs[0] == std::set<size_t>({5}));
+	assert(find_sccs(finder, g, 2).empty());
+
+	/* searches after clearing the finder start afresh */
+	finder.clear();
+	sccs = find_sccs(finder, g, 2);
+	assert(sccs.size() == 2);
+	assert(sccs[0] == std::set<size_t>({3, 4}));
+	assert(sccs[1] == std::set<size_t>({1, 2}));
+}
+
+static void
+test_chain()
+{
+	/*
+		The chain is far deeper than a recursive search could handle. The users
+		of the finder, i.e., the cfg and ipgraph searches, rely on this test and
+		only check small graphs.
+	*/
+	size_t nnodes = 1000000;
+
+	graph g(nnodes);
+	for (size_t n = 0; n < nnodes-1; n++)
+		g[n].push_back(n+1);
+
+	/* every node is its own component, emitted in reverse topological order */
+	jlm::sccfinder finder;
+	auto sccs = find_sccs(finder, g, 0);
+	assert(sccs.size() == nnodes);
+	for (size_t n = 0; n < nnodes; n++)
+		assert(sccs[n] == std::set<size_t>({nnodes-1-n}));
+
+	/* a back edge from the last to the first node closes the chain */
+	g.back().push_back(0);
+	finder.clear();
+	sccs = find_sccs(finder, g, 0);
+	assert(sccs.size() == 1 && sccs[0].size() == nnodes);
+}
+
+static int
+test()
+{
+	test_components();
+	test_chain();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("util/test-scc", test)
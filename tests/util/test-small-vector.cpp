@@ -0,0 +1,39 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/util/small-vector.hpp>
+
+#include <assert.h>
+
+#include <vector>
+
+static int
+test()
+{
+	jlm::small_vector<int, 2> v1({1, 2});
+	assert(v1.size() == 2 && v1.is_inline());
+	assert(v1[0] == 1 && v1[1] == 2);
+
+	v1.push_back(3);
+	assert(v1.size() == 3 && !v1.is_inline());
+	assert(std::vector<int>(v1.begin(), v1.end()) == std::vector<int>({1, 2, 3}));
+
+	auto v2 = v1;
+	assert(v2.size() == 3 && v2[2] == 3);
+
+	auto v3 = std::move(v1);
+	assert(v3.size() == 3 && v1.empty() && v1.is_inline());
+
+	std::vector<int> elements({4});
+	jlm::small_vector<int, 2> v4(elements.begin(), elements.end());
+	v3 = std::move(v4);
+	assert(v3.size() == 1 && v3[0] == 4 && v3.is_inline());
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("util/test-small-vector", test)
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/common.hpp>
+#include <jlm/util/stats.hpp>
+#include <jlm/util/strfmt.hpp>
+
+#include <assert.h>
+#include <unistd.h>
+
+#include <fstream>
+
+class teststat final : public jlm::stat {
+public:
+	virtual
+	~teststat()
+	{}
+
+	teststat()
+	: stat(jlm::statid::cne)
+	{}
+
+	virtual std::vector<jlm::statfield>
+	fields() const override
+	{
+		return {{"function", "f\"1"}, {"nnodes", 42}};
+	}
+};
+
+static std::vector<std::string>
+print(const jlm::statformat & format)
+{
+	jlm::filepath path("/tmp/jlm-test-stats.log");
+	unlink(path.to_str().c_str());
+
+	{
+		jlm::stats_descriptor sd(path);
+		sd.set_format(format);
+		sd.print_stat(teststat());
+		sd.print_stat(teststat());
+	}
+
+	std::string line;
+	std::vector<std::string> lines;
+	std::ifstream ifs(path.to_str());
+	while (std::getline(ifs, line))
+		lines.push_back(line);
+
+	unlink(path.to_str().c_str());
+	return lines;
+}
+
+static void
+test_formats()
+{
+	auto lines = print(jlm::statformat::text);
+	assert(lines.size() == 2 && lines[0] == "CNE f\"1 42");
+
+	lines = print(jlm::statformat::json);
+	assert(lines.size() == 2);
+	assert(lines[0].find("{\"stat\":\"cne\",\"function\":\"f\\\"1\",\"nnodes\":42,") == 0);
+	assert(lines[0].find("\"peak_rss_kb\":") != std::string::npos);
+
+	lines = print(jlm::statformat::csv);
+	assert(lines.size() == 3);
+	assert(lines[0] == "stat,function,nnodes,peak_rss_kb");
+	assert(lines[1].find("cne,\"f\"\"1\",42,") == 0);
+}
+
+static void
+test_quote_json()
+{
+	assert(quote_json("f\"1\\") == "\"f\\\"1\\\\\"");
+	assert(quote_json("a\nb\tc") == "\"a\\nb\\tc\"");
+	assert(quote_json(std::string("\x01\x1f", 2)) == "\"\\u0001\\u001f\"");
+}
+
+static void
+test_enable()
+{
+	jlm::stats_descriptor sd;
+	assert(!sd.is_enabled(jlm::statid::cne));
+
+	sd.enable(jlm::to_statid("cne"));
+	assert(sd.is_enabled(jlm::statid::cne));
+	assert(!sd.is_enabled(jlm::statid::dne));
+
+	sd.enable_all();
+	for (const auto & id : jlm::all_statids()) {
+		assert(sd.is_enabled(id));
+		assert(jlm::to_statid(jlm::to_str(id)) == id);
+	}
+
+	bool thrown = false;
+	try {
+		jlm::to_statid("foo");
+	} catch (jlm::error &) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+static int
+test()
+{
+	test_formats();
+	test_quote_json();
+	test_enable();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("util/test-stats", test)
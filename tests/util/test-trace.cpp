@@ -0,0 +1,49 @@
+/*
+ * Copyright 2020 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jlm/util/trace.hpp>
+
+#include <assert.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+static int
+test()
+{
+	auto & tracer = jlm::tracer::global();
+	tracer.clear();
+
+	{
+		jlm::trace_scope scope("phase", "disabled");
+	}
+
+	tracer.enable();
+	{
+		jlm::trace_scope outer("phase", "outer");
+		jlm::trace_scope inner("function", "f\"1");
+	}
+
+	jlm::filepath path("/tmp/jlm-test-trace.json");
+	tracer.write(path);
+
+	std::ifstream ifs(path.to_str());
+	std::stringstream ss;
+	ss << ifs.rdbuf();
+	auto str = ss.str();
+	unlink(path.to_str().c_str());
+
+	assert(str.find("{\"traceEvents\":[") == 0);
+	assert(str.find("\"disabled\"") == std::string::npos);
+	assert(str.find("\"name\":\"outer\",\"cat\":\"phase\",\"ph\":\"X\"") != std::string::npos);
+	assert(str.find("\"name\":\"f\\\"1\",\"cat\":\"function\"") != std::string::npos);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("util/test-trace", test)